@@ -0,0 +1,20 @@
+#ifndef TRABALHO_PRATICO_AIRCRAFT_RANKING_H
+#define TRABALHO_PRATICO_AIRCRAFT_RANKING_H
+
+#include "database.h"
+#include <stddef.h>
+
+// Q2 rankings: every aircraft sorted by (flight count desc, id asc), and
+// the same order restricted to each manufacturer. A query reads the first
+// N entries of one of them.
+typedef struct aircraft_ranking AircraftRanking;
+
+// Snapshot of the aircrafts and flight counts currently in the database
+AircraftRanking* aircraft_ranking_build(Database* db);
+void aircraft_ranking_destroy(AircraftRanking* ranking);
+
+// Ranked aircrafts of `manufacturer` (NULL: all of them); *count is 0 and
+// the result NULL if there are none
+Aircraft* const* aircraft_ranking_get(const AircraftRanking* ranking, const char* manufacturer, size_t* count);
+
+#endif
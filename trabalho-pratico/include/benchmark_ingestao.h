@@ -0,0 +1,10 @@
+#ifndef BENCHMARK_INGESTAO_H
+#define BENCHMARK_INGESTAO_H
+
+// Mede a latência entre acrescentar uma linha a flights.csv e o voo ficar
+// visível numa consulta, com o modo --live, a vários ritmos de escrita.
+// Usa os aeroportos e aeronaves de dataset_path numa cópia temporária.
+// Devolve 0 em caso de sucesso.
+int run_live_ingest_benchmark(const char* dataset_path);
+
+#endif // BENCHMARK_INGESTAO_H
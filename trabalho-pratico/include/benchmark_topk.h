@@ -0,0 +1,12 @@
+#ifndef BENCHMARK_TOPK_H
+#define BENCHMARK_TOPK_H
+
+#include <stddef.h>
+
+// Compara top_k_select (chaves de 64 bits) com o caminho antigo das
+// queries (qsort de apontadores com strcmp) para k = 1, 10 e 1000 sobre
+// `candidates` candidatos pseudo-aleatórios. Verifica que ambos dão o
+// mesmo ranking. Devolve o número de divergências.
+int run_topk_benchmark(size_t candidates, unsigned seed);
+
+#endif // BENCHMARK_TOPK_H
@@ -0,0 +1,16 @@
+#ifndef CONTADOR_ALOCACOES_H
+#define CONTADOR_ALOCACOES_H
+
+#include <stddef.h>
+
+// Contador de chamadas ao heap do programa de testes. O malloc, calloc,
+// realloc e free da libc são substituídos por versões que contam cada
+// chamada (incluindo as feitas dentro da própria libc) e depois delegam
+// na libc. Só é ligado ao programa de testes.
+
+// Alocações (malloc, calloc, realloc) e libertações (free de um apontador
+// não nulo) feitas desde o início do programa
+size_t contador_alocacoes(void);
+size_t contador_libertacoes(void);
+
+#endif // CONTADOR_ALOCACOES_H
@@ -2,6 +2,10 @@
 #define TRABALHO_PRATICO_CONTROLLER_H
 
 #include "database.h"
+#include "index_manager.h"
+#include "ingestor.h"
+#include "query_cache.h"
+#include "query_plan.h"
 #include <stdio.h>
 
 typedef struct controller Controller;
@@ -10,7 +14,35 @@ typedef struct controller Controller;
 Controller* controller_create(Database* db);
 void controller_destroy(Controller* ctrl);
 
-// Execute a single query line and write output to file
+// Execute a single query line and write output to file. Several threads
+// may execute queries at once as long as the tables those queries read do
+// not change meanwhile: structures built on first use are shared under a
+// lock, and are only rebuilt after rows were added.
 int controller_execute_query(Controller* ctrl, const char* query_line, FILE* output);
 
+// Same, for a query already compiled (see query_plan.h)
+int controller_execute_compiled(Controller* ctrl, const CompiledQuery* query, FILE* output);
+
+// Lookups and hits of the query result cache. Repeated queries replay the
+// output of the first one until a table they read gains rows.
+QueryCacheStats controller_cache_stats(Controller* ctrl);
+
+// Announces a query that will be executed later, so that queries of the
+// same kind can be evaluated together (all Q3 ranges in one sweep through
+// the flights). Optional; other queries are ignored.
+int controller_plan_query(Controller* ctrl, const CompiledQuery* query);
+
+// Starts building, on a background thread, the indexes the queries of
+// `plan` will read, as soon as `ingestor` has loaded their tables. Call
+// after the plan's queries were announced; without it every index is
+// built by the first query that needs it.
+int controller_prebuild_indexes(Controller* ctrl, const QueryPlan* plan, Ingestor* ingestor);
+
+// Indexes built for the queries, with their build counts and times
+int controller_index_count(const Controller* ctrl);
+IndexStats controller_index_stats(Controller* ctrl, int id);
+
+// Tables a query reads, as INGEST_* bits (0 for unknown queries)
+unsigned controller_query_tables(const CompiledQuery* query);
+
 #endif
@@ -6,14 +6,32 @@
 #include "flights.h"
 #include "passengers.h"
 #include "reservations.h"
+#include "departure_days.h"
+#include <stdbool.h>
 #include <stddef.h>
 
 typedef struct database Database;
 
+// Expected number of entities per table (0: default size). Tables still
+// grow past their size, but a good estimate avoids every rehash.
+typedef struct {
+    size_t airports;
+    size_t aircrafts;
+    size_t flights;
+    size_t passengers;
+    size_t reservations;
+} DatabaseSizing;
+
 // Lifecycle
 Database* database_create(void);
+Database* database_create_sized(const DatabaseSizing* sizing);
 void database_destroy(Database* db);
 
+// Validation-only database: parsers store skeleton entities holding just the
+// keys (and flight routes) needed by cross-table reference checks
+Database* database_create_keys_only(void);
+bool database_is_keys_only(const Database* db);
+
 // Add entities (returns 0 on success, -1 on error/duplicate)
 int database_add_airport(Database* db, Airport* airport);
 int database_add_aircraft(Database* db, Aircraft* aircraft);
@@ -28,6 +46,17 @@ Flight* database_get_flight(Database* db, const char* id);
 Passenger* database_get_passenger(Database* db, const char* doc_number);
 Reservation* database_get_reservation(Database* db, const char* id);
 
+// Per-day departure aggregate for Q3, maintained by the flights parser
+// (NULL for a validation-only database)
+DepartureDays* database_get_departure_days(Database* db);
+
+// Number of entities stored (cheap: no array is built)
+size_t database_count_airports(Database* db);
+size_t database_count_aircrafts(Database* db);
+size_t database_count_flights(Database* db);
+size_t database_count_passengers(Database* db);
+size_t database_count_reservations(Database* db);
+
 // Get all entities (for queries that need to iterate)
 Airport** database_get_all_airports(Database* db, size_t* count);
 Aircraft** database_get_all_aircrafts(Database* db, size_t* count);
@@ -0,0 +1,59 @@
+#ifndef TRABALHO_PRATICO_DATASET_PROFILE_H
+#define TRABALHO_PRATICO_DATASET_PROFILE_H
+
+#include "database.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// Quick statistics of a dataset directory, gathered by programa-perfil and
+// saved as a small "<table>.<stat> <value>" text file. The main program
+// reads the key counts back to pre-size the database tables.
+
+// Default location, inside the dataset directory
+#define DATASET_PROFILE_FILE "profile.txt"
+
+#define PROFILE_TABLE_COUNT 5
+#define PROFILE_MAX_COLUMNS 4
+
+typedef struct {
+    const char* name;
+    size_t distinct;
+} ColumnProfile;
+
+typedef struct {
+    const char* name;
+    const char* first;             // smallest value (empty if none was valid)
+    const char* last;
+    char first_buffer[17];
+    char last_buffer[17];
+} DateRangeProfile;
+
+typedef struct {
+    const char* name;              // file stem, e.g. "flights"
+    bool found;
+    size_t rows;                   // data rows (header excluded)
+    size_t keys;                   // distinct primary keys
+    ColumnProfile columns[PROFILE_MAX_COLUMNS];    // low-cardinality columns
+    int column_count;
+    DateRangeProfile dates[2];
+    int date_count;
+    size_t line_min;               // line lengths in bytes, '\n' excluded
+    size_t line_p50;
+    size_t line_p99;
+    size_t line_max;
+} TableProfile;
+
+typedef struct {
+    TableProfile tables[PROFILE_TABLE_COUNT];   // airports, aircrafts, passengers, flights, reservations
+} DatasetProfile;
+
+// Scans every table of the dataset (missing files are left with found = false)
+bool dataset_profile_scan(const char* dataset_path, DatasetProfile* profile);
+
+bool dataset_profile_save(const DatasetProfile* profile, const char* path);
+
+// Reads the table sizes out of a saved profile (false if it cannot be read)
+bool dataset_profile_load_sizing(const char* path, DatabaseSizing* sizing);
+
+#endif
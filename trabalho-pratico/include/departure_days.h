@@ -0,0 +1,33 @@
+#ifndef TRABALHO_PRATICO_DEPARTURE_DAYS_H
+#define TRABALHO_PRATICO_DEPARTURE_DAYS_H
+
+#include "airports.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <time.h>
+
+// Materialized Q3 aggregate: non-cancelled departures per airport and per
+// day, kept up to date as flights are loaded. Per-airport prefix
+// sums over the days make any whole-day range cost one subtraction per
+// airport, however many flights it covers. The grid spans at most ~11
+// years; departures beyond that (outlier dates) are left out of it and
+// ranges reaching them are not answered.
+typedef struct departure_days DepartureDays;
+
+DepartureDays* departure_days_create(void);
+void departure_days_destroy(DepartureDays* days);
+
+// Counts one departure of `airport` at `when` (effective departure time).
+// If memory runs out the aggregate disables itself and answers nothing.
+void departure_days_add(DepartureDays* days, Airport* airport, time_t when);
+
+// Busiest airport from `first_day` to 86399 s after `last_day` (both
+// midnights from parse_date), ties broken by the smallest code;
+// *departures is 0 if no airport departed in the range. Returns false if
+// the aggregate cannot answer exactly (a bound off its day grid, e.g.
+// across a change of the zone's standard offset, or a range reaching
+// departures left out of the grid), so the caller must count some other way.
+bool departure_days_busiest(DepartureDays* days, time_t first_day, time_t last_day,
+                            Airport** airport, size_t* departures);
+
+#endif
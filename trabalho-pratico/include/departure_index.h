@@ -0,0 +1,36 @@
+#ifndef TRABALHO_PRATICO_DEPARTURE_INDEX_H
+#define TRABALHO_PRATICO_DEPARTURE_INDEX_H
+
+#include "database.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <time.h>
+
+// Q3 index: for every airport, the sorted effective departure times of
+// its non-cancelled flights (actual departure, or the scheduled one when
+// there is no actual). Counting an airport's departures in a range is
+// then two binary searches.
+typedef struct departure_index DepartureIndex;
+
+// Snapshot of the flights currently in the database
+DepartureIndex* departure_index_build(Database* db);
+void departure_index_destroy(DepartureIndex* index);
+
+// The flights Q3 counts, shared with the batch evaluator: false for a
+// cancelled flight, else *departure is its effective departure time
+bool departure_index_effective_departure(Flight* flight, time_t* departure);
+
+// Every airport, sorted by code (free() it; NULL if memory ran out).
+// Scanning them in this order and keeping the first maximum breaks ties
+// by the smallest code, as Q3 requires.
+Airport** departure_index_sorted_airports(Database* db, size_t* count);
+
+// Position of `code` in code-sorted `airports`, or `count` if absent
+size_t departure_index_find_airport(Airport* const* airports, size_t count, const char* code);
+
+// Airport with the most departures in [from, to], ties broken by the
+// smallest code. NULL if there are no airports; *departures is 0 if no
+// airport has departures in the range.
+Airport* departure_index_busiest(const DepartureIndex* index, time_t from, time_t to, size_t* departures);
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef TRABALHO_PRATICO_INDEX_MANAGER_H
+#define TRABALHO_PRATICO_INDEX_MANAGER_H
+
+#include "database.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// Registry of the structures derived from the database for queries
+// (rankings, timelines, batches). Each one is built the first time a query
+// asks for it, or ahead of time on a background thread when the workload
+// is known to need it, and rebuilt when the tables it reads gained rows.
+// Safe to use from several threads: a structure being built is waited for,
+// never built twice, and a stale one is only destroyed once every thread
+// that got it released it.
+typedef struct index_manager IndexManager;
+
+#define INDEX_MANAGER_MAX 8
+
+typedef struct {
+    const char* name;
+    unsigned tables;               // INGEST_* bits of the tables it reads
+    void* (*build)(Database* db, void* context);   // NULL if it cannot be built
+    void (*destroy)(void* index);
+    size_t (*cost)(Database* db, void* context);   // estimated rows processed by a build
+    void* context;
+} IndexSpec;
+
+typedef struct {
+    const char* name;
+    int builds;
+    double build_seconds;          // all builds together
+    size_t cost;                   // estimate for the last build
+} IndexStats;
+
+IndexManager* index_manager_create(Database* db);
+void index_manager_destroy(IndexManager* manager);     // waits for background builds
+
+// Returns the index id (-1 if INDEX_MANAGER_MAX indexes are registered)
+int index_manager_register(IndexManager* manager, const IndexSpec* spec);
+
+// The index for the current rows, built now if needed (NULL if its build
+// failed; it is retried once its tables change). A non-NULL result stays
+// valid until it is released; a thread must not get the same index again
+// before releasing it, since a rebuild waits for the release.
+void* index_manager_get(IndexManager* manager, int id);
+void index_manager_release(IndexManager* manager, int id);
+
+// Makes the next get rebuild the index, for indexes that also depend on
+// something other than the tables (e.g. the queries announced so far)
+void index_manager_invalidate(IndexManager* manager, int id);
+
+// Builds the indexes in `ids` (bit i: index i) on a background thread,
+// most expensive first, once wait_tables(context, tables) has returned for
+// the tables they read. False if the thread could not be started.
+bool index_manager_build_in_background(IndexManager* manager, unsigned ids,
+                                       void (*wait_tables)(void* context, unsigned tables),
+                                       void* context);
+
+int index_manager_count(const IndexManager* manager);
+IndexStats index_manager_stats(IndexManager* manager, int id);
+
+#endif
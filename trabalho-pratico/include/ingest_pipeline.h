@@ -0,0 +1,36 @@
+#ifndef TRABALHO_PRATICO_INGEST_PIPELINE_H
+#define TRABALHO_PRATICO_INGEST_PIPELINE_H
+
+#include "parser_engine.h"
+#include "line_reader.h"
+#include "reject_log.h"
+#include <stdbool.h>
+#include <sys/types.h>
+
+// Multi-threaded variant of the engine's row loop:
+//   reader thread -> N validator threads -> inserter (the calling thread)
+// Rows travel in batches over single-producer/single-consumer rings. Batch
+// i goes to validator i % N and the inserter takes batch i back from that
+// validator, so rows are inserted and logged in file order. A fixed pool
+// of batches bounds memory: the reader stalls when every batch is in flight.
+
+typedef struct {
+    int valid_count;
+    int error_count;
+    off_t consumed;        // source bytes of the rows processed
+    bool failed;           // a row could not be buffered or checked; processing stopped there
+} PipelineResult;
+
+// Number of validator threads worth starting for the rest of `filepath`
+// from `offset` on this machine (0: use the serial loop)
+int ingest_pipeline_validators(const char* filepath, off_t offset);
+
+// Processes every remaining row of `reader` (its discard hook must be
+// unset). consumed is the reader's current source offset; row indices
+// start at 0. Returns false, having read nothing, if the threads could not
+// be started.
+bool ingest_pipeline_run(LineReader* reader, const TableSchema* schema, Database* db,
+                         RejectLog* rejects, bool complete_lines_only, void* context,
+                         off_t consumed, int validators, PipelineResult* result);
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef TRABALHO_PRATICO_INGESTOR_H
+#define TRABALHO_PRATICO_INGESTOR_H
+
+#include "database.h"
+#include <stdbool.h>
+
+// Loads the five dataset tables into a Database and keeps, per table, the
+// error log and a checkpoint so rows appended later can be ingested
+typedef struct ingestor Ingestor;
+
+// Table bits, for loading a subset of the dataset
+#define INGEST_AIRPORTS     (1u << 0)
+#define INGEST_AIRCRAFTS    (1u << 1)
+#define INGEST_PASSENGERS   (1u << 2)
+#define INGEST_FLIGHTS      (1u << 3)
+#define INGEST_RESERVATIONS (1u << 4)
+#define INGEST_ALL          0x1Fu
+
+// Rows stored in the given tables of `db`. Tables only grow, so a
+// different count means rows were added to one of them.
+size_t ingestor_count_rows(Database* db, unsigned tables);
+
+// Lifecycle: creates <results_dir>/<table>_errors.csv for every table.
+// In incremental mode a last line without '\n' is left for a later round,
+// and a table only present as <table>.csv.gz is refused (NULL): rows
+// appended to it could not be read.
+Ingestor* ingestor_create(const char* dataset_path, const char* results_dir, Database* db, bool incremental);
+void ingestor_destroy(Ingestor* ingestor);
+
+// Loads every table from the start, in dependency order
+int ingestor_load_all(Ingestor* ingestor);
+
+// Loads the given tables and the ones they reference (flights need airports
+// and aircrafts, reservations need passengers and flights). Tables already
+// loaded are skipped; tables another thread is loading are waited for, so
+// on return every requested table is ready to be read.
+int ingestor_load_tables(Ingestor* ingestor, unsigned tables);
+unsigned ingestor_loaded_tables(Ingestor* ingestor);
+
+// Starts loading the given tables (and their references) on background
+// threads, one per table, independent tables in parallel. Use
+// ingestor_load_tables to wait for the ones about to be read, and
+// ingestor_wait to join every loader.
+int ingestor_load_in_background(Ingestor* ingestor, unsigned tables);
+void ingestor_wait(Ingestor* ingestor);
+
+// Ingests the rows appended to each loaded table since the last load. Returns the
+// number of new rows (valid + rejected), or -1 if a file was rewritten
+// instead of appended to (that table is then left untouched)
+int ingestor_ingest_appended(Ingestor* ingestor);
+
+#endif
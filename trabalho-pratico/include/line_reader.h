@@ -0,0 +1,49 @@
+#ifndef TRABALHO_PRATICO_LINE_READER_H
+#define TRABALHO_PRATICO_LINE_READER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <sys/types.h>
+
+typedef struct line_reader LineReader;
+
+// The file line_reader_open reads for `filepath`: itself, or filepath.gz if
+// only the compressed file exists (*compressed tells which). False if
+// neither can be read.
+bool line_reader_source(const char* filepath, char* path, size_t size, bool* compressed);
+
+// Bytes line_reader_open would read from `filepath` (for gzip, the size
+// recorded in its trailer, exact below 4 GiB); -1 if there is no source
+off_t line_reader_source_size(const char* filepath);
+
+// Lifecycle (returns NULL if the file cannot be opened)
+LineReader* line_reader_open(const char* filepath);
+// Starts reading at byte `offset` (plain files only: compressed sources
+// cannot be resumed and return NULL for offset > 0)
+LineReader* line_reader_open_at(const char* filepath, off_t offset);
+void line_reader_close(LineReader* reader);
+
+// Reads the next line of any length. On success *line points into the
+// reader's buffer (valid until the next call), without the trailing '\n'
+// and NUL-terminated; *length is its length and *had_newline tells whether
+// a '\n' terminated it. Returns false at end of file.
+bool line_reader_next(LineReader* reader, char** line, size_t* length, bool* had_newline);
+
+// True if line_reader_next returned false before the end of the file:
+// a line did not fit in memory or the source could not be read. The
+// lines returned until then are complete; the rest were not returned.
+bool line_reader_failed(const LineReader* reader);
+
+// File offset of the line last returned by line_reader_next
+off_t line_reader_line_offset(const LineReader* reader);
+
+// Current buffer and the file offset of its first byte
+const char* line_reader_buffer(const LineReader* reader, off_t* buffer_offset);
+
+// Called with the current buffer right before already returned lines are
+// discarded (when the buffer is refilled and when the reader is closed)
+void line_reader_set_discard_hook(LineReader* reader,
+                                  void (*hook)(void* ctx, const char* buffer, off_t buffer_offset),
+                                  void* ctx);
+
+#endif
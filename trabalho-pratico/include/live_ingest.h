@@ -0,0 +1,21 @@
+#ifndef TRABALHO_PRATICO_LIVE_INGEST_H
+#define TRABALHO_PRATICO_LIVE_INGEST_H
+
+#include "ingestor.h"
+
+// Background watcher: ingests the lines appended to the dataset directory
+// as soon as inotify reports a change. Readers of the Database bracket each
+// query with live_ingest_read_begin/end and never see a half-applied round.
+// Plain CSV tables only: appends are read by offset, which a .csv.gz does
+// not have, so the ingestor of a live run refuses compressed tables.
+typedef struct live_ingest LiveIngest;
+
+// Lifecycle: the ingestor must already hold the initial load
+LiveIngest* live_ingest_start(Ingestor* ingestor, const char* dataset_path);
+void live_ingest_stop(LiveIngest* live);
+
+// Consistent view of the Database for the duration of one query
+void live_ingest_read_begin(LiveIngest* live);
+void live_ingest_read_end(LiveIngest* live);
+
+#endif
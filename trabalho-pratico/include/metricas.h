@@ -1,6 +1,7 @@
 #ifndef METRICAS_H
 #define METRICAS_H
 
+#include <stddef.h>
 #include <time.h>
 
 // Estrutura simples de tempo usando apenas time.h
@@ -38,6 +39,21 @@ double get_program_metrics_total_time(const ProgramMetrics* metrics);
 
 void set_program_metrics_total_time(ProgramMetrics* metrics, double total_time);
 
+// Acertos da cache de resultados do controller
+void set_program_metrics_cache(ProgramMetrics* metrics, size_t lookups, size_t hits);
+
+// Chamadas ao heap (alocações e libertações) feitas pelas queries, no
+// total e sem contar a primeira query de cada tipo (que constrói os índices)
+void set_program_metrics_alocacoes(ProgramMetrics* metrics, size_t total, size_t estaveis);
+
+// Construções de um índice do controller (feitas na primeira query que o
+// usa, ou em segundo plano): quantas, tempo total e custo estimado
+void add_index_metrics(ProgramMetrics* metrics, const char* nome, int construcoes,
+                       double tempo, size_t custo);
+
 void free_program_metrics(ProgramMetrics* metrics);
 
+// Rejeições por regra e tempo por etapa dos parsers (só com -DPARSE_STATS)
+void print_parse_stats_report(void);
+
 #endif // METRICAS_H
\ No newline at end of file
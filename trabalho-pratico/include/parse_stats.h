@@ -0,0 +1,93 @@
+#ifndef TRABALHO_PRATICO_PARSE_STATS_H
+#define TRABALHO_PRATICO_PARSE_STATS_H
+
+#include "parser_engine.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Parser instrumentation: per-table rejection counters by rule and
+// cumulative time per ingestion stage. Only compiled in with -DPARSE_STATS
+// (the test program is built that way); otherwise every macro below is
+// a no-op and the parsers carry no extra code.
+
+typedef enum {
+    STAGE_READ,        // line reader
+    STAGE_SPLIT,       // copy + CSV split
+    STAGE_VALIDATE,    // format and cross-field checks
+    STAGE_LOOKUP,      // cross-table references
+    STAGE_CREATE,      // entity construction
+    STAGE_INSERT,      // database insertion
+    STAGE_LOG,         // error log
+    STAGE_WAIT,        // pipeline threads stalled on a full or empty ring
+    STAGE_COUNT
+} ParseStage;
+
+#define PARSE_STATS_MAX_TABLES 8
+#define PARSE_STATS_MAX_FIELDS 16
+#define PARSE_STATS_MAX_RULES 16
+
+typedef enum { FIELD_MISSING, FIELD_INVALID, FIELD_UNRESOLVED, FIELD_RULE_COUNT } FieldRule;
+
+typedef struct {
+    const char* name;          // string literal given to PARSE_REJECT
+    uint64_t count;
+} RuleCount;
+
+typedef struct {
+    const char* table_name;
+    int field_count;
+    const char* field_names[PARSE_STATS_MAX_FIELDS];
+    uint64_t rows;
+    uint64_t short_rows;                                          // fewer fields than the schema
+    uint64_t field_rejects[PARSE_STATS_MAX_FIELDS][FIELD_RULE_COUNT];
+    RuleCount rules[PARSE_STATS_MAX_RULES];                       // load_row rules
+    int rule_count;
+    uint64_t stage_ns[STAGE_COUNT];
+} ParseTableStats;
+
+#ifdef PARSE_STATS
+
+// Makes the schema's table the current one of the calling thread and
+// restarts its lap clock
+void parse_stats_begin(const TableSchema* schema);
+void parse_stats_end(void);
+
+// Charges the time since the previous lap to `stage`
+void parse_stats_lap(ParseStage stage);
+
+void parse_stats_row(void);
+void parse_stats_short_row(void);
+void parse_stats_field_reject(int field, FieldRule rule);
+void parse_stats_rule_reject(const char* rule);
+
+// Clears every table's counters
+void parse_stats_reset(void);
+
+// Collected tables, in first-seen order
+int parse_stats_table_count(void);
+const ParseTableStats* parse_stats_table(int index);
+
+#define PARSE_STATS_RESET() parse_stats_reset()
+#define PARSE_STATS_BEGIN(schema) parse_stats_begin(schema)
+#define PARSE_STATS_END() parse_stats_end()
+#define PARSE_STATS_LAP(stage) parse_stats_lap(stage)
+#define PARSE_STATS_ROW() parse_stats_row()
+#define PARSE_STATS_SHORT_ROW() parse_stats_short_row()
+#define PARSE_STATS_FIELD_REJECT(field, rule) parse_stats_field_reject(field, rule)
+// load_row hooks: `return PARSE_REJECT("rule");` instead of `return false;`
+#define PARSE_REJECT(rule) (parse_stats_rule_reject(rule), false)
+
+#else
+
+#define PARSE_STATS_RESET() ((void)0)
+#define PARSE_STATS_BEGIN(schema) ((void)0)
+#define PARSE_STATS_END() ((void)0)
+#define PARSE_STATS_LAP(stage) ((void)0)
+#define PARSE_STATS_ROW() ((void)0)
+#define PARSE_STATS_SHORT_ROW() ((void)0)
+#define PARSE_STATS_FIELD_REJECT(field, rule) ((void)0)
+#define PARSE_REJECT(rule) false
+
+#endif
+
+#endif
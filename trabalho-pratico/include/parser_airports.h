@@ -2,8 +2,12 @@
 #define TRABALHO_PRATICO_PARSER_AIRPORTS_H
 
 #include "database.h"
+#include "parser_engine.h"
 #include <stdio.h>
 
 int parse_airports(const char* filepath, Database* db, FILE* error_log);
 
+// Schema used by the ingestion engine
+extern const TableSchema AIRPORTS_SCHEMA;
+
 #endif
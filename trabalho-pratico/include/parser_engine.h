@@ -0,0 +1,68 @@
+#ifndef TRABALHO_PRATICO_PARSER_ENGINE_H
+#define TRABALHO_PRATICO_PARSER_ENGINE_H
+
+#include "database.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <sys/types.h>
+
+#define PARSER_MAX_FIELDS 16
+
+// Description of one CSV column
+typedef struct {
+    const char* name;                                // column name (documentation only)
+    bool required;                                   // row is rejected if the field is empty
+    bool (*validate)(const char* value);             // format check, applied when non-empty (optional)
+    void* (*lookup)(Database* db, const char* key);  // cross-table reference, must resolve (optional)
+} FieldSpec;
+
+// One split row handed to the table-specific stage
+typedef struct {
+    char** fields;                     // field values, in schema order
+    void* refs[PARSER_MAX_FIELDS];     // resolved references (NULL where no lookup)
+    size_t index;                      // data row number within this call
+    void* context;                     // result of schema->prepare (NULL if none)
+} ParsedRow;
+
+// Per-table schema: column checks are done by the engine, the remaining
+// cross-field checks, conversions, creation and insertion by load_row.
+typedef struct {
+    const char* table_name;            // used in the "N valid, M errors" summary
+    int field_count;
+    const FieldSpec* fields;
+    // Returns true if the row was stored, false if it must go to the error log
+    bool (*load_row)(const ParsedRow* row, Database* db);
+    // Optional bulk pre-pass over the rows at `offset` onwards (the header
+    // is skipped when offset is 0). Returns per-row data for load_row, or
+    // NULL to leave every check to the row loop.
+    void* (*prepare)(const char* filepath, off_t offset, Database* db);
+    void (*release)(void* context);
+} TableSchema;
+
+// Resume point of a table for incremental ingestion
+typedef struct {
+    off_t offset;                  // source bytes consumed so far (0: header not read yet)
+    uint64_t fingerprint;          // fingerprint of the consumed bytes
+    bool complete_lines_only;      // leave a last line without '\n' for the next round
+    int valid_count;               // rows stored by the last call
+    int error_count;               // rows rejected by the last call
+} TableCheckpoint;
+
+#define PARSE_SOURCE_REWRITTEN (-2)
+
+// Column checks: required fields, format validators and references.
+// Returns false as soon as one fails. Only reads the database.
+bool parser_check_fields(const TableSchema* schema, ParsedRow* row, Database* db);
+
+// Generic CSV ingestion loop driven by a schema
+int parse_table(const char* filepath, const TableSchema* schema, Database* db, FILE* error_log);
+
+// Same, but only consumes the bytes appended since `checkpoint` and then
+// advances it. Rejected rows are appended to error_log. Returns
+// PARSE_SOURCE_REWRITTEN (nothing ingested) if the consumed part of the
+// file was truncated or changed since the checkpoint.
+int parse_table_resume(const char* filepath, const TableSchema* schema, Database* db,
+                       FILE* error_log, TableCheckpoint* checkpoint);
+
+#endif
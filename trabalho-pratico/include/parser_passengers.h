@@ -2,8 +2,12 @@
 #define TRABALHO_PRATICO_PARSER_PASSENGERS_H
 
 #include "database.h"
+#include "parser_engine.h"
 #include <stdio.h>
 
 int parse_passengers(const char* filepath, Database* db, FILE* error_log);
 
+// Schema used by the ingestion engine
+extern const TableSchema PASSENGERS_SCHEMA;
+
 #endif
@@ -2,8 +2,12 @@
 #define TRABALHO_PRATICO_PARSER_RESERVATIONS_H
 
 #include "database.h"
+#include "parser_engine.h"
 #include <stdio.h>
 
 int parse_reservations(const char* filepath, Database* db, FILE* error_log);
 
+// Schema used by the ingestion engine
+extern const TableSchema RESERVATIONS_SCHEMA;
+
 #endif
@@ -4,6 +4,23 @@
 #include <stdbool.h>
 #include <time.h>
 
+// Enumerated field values
+typedef enum {
+    AIRPORT_TYPE_INVALID = -1,
+    AIRPORT_TYPE_SMALL,
+    AIRPORT_TYPE_MEDIUM,
+    AIRPORT_TYPE_LARGE,
+    AIRPORT_TYPE_HELIPORT,
+    AIRPORT_TYPE_SEAPLANE_BASE
+} AirportType;
+
+typedef enum {
+    FLIGHT_STATUS_OTHER = -1,
+    FLIGHT_STATUS_ON_TIME,
+    FLIGHT_STATUS_DELAYED,
+    FLIGHT_STATUS_CANCELLED
+} FlightStatus;
+
 // CSV parsing for quoted fields
 int parse_csv_line(char* line, char** fields, int max_fields);
 
@@ -24,6 +41,22 @@ bool validate_flight_id(const char* id);
 bool validate_reservation_id(const char* id);
 bool validate_document_number(const char* doc);
 
+// Rows are split into buffers that keep FIELD_PADDING readable bytes past
+// the end of the row. The *_padded validators rely on it to check a whole
+// fixed-width field with 16-byte loads; they must only be given values
+// inside such a buffer (the parsers' field tables and row loaders).
+#define FIELD_PADDING 16
+
+bool validate_date_padded(const char* date_str);
+bool validate_datetime_padded(const char* datetime_str);
+bool validate_flight_id_padded(const char* id);
+bool validate_reservation_id_padded(const char* id);
+bool validate_document_number_padded(const char* doc);
+
+// Enumerated value classifiers
+AirportType classify_airport_type(const char* type);
+FlightStatus classify_flight_status(const char* status);
+
 // Utility functions
 char* trim_whitespace(char* str);
 bool is_empty_field(const char* field);
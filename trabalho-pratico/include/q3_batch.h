@@ -0,0 +1,23 @@
+#ifndef TRABALHO_PRATICO_Q3_BATCH_H
+#define TRABALHO_PRATICO_Q3_BATCH_H
+
+#include "database.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <time.h>
+
+// Offline evaluation of many Q3 ranges at once: the range endpoints are
+// sorted and one sweep through the flights, in effective departure order,
+// keeps per-airport running counts and snapshots them at each endpoint.
+// N ranges cost one sort of the flights plus N x airports.
+typedef struct {
+    time_t from;               // first second counted
+    time_t to;                 // last second counted
+    Airport* airport;          // result: busiest airport, ties by smallest code (NULL: no airports)
+    size_t departures;         // result: its departures in the range (0: none)
+} Q3Range;
+
+// Fills in the result of every range; false if memory ran out
+bool q3_batch_evaluate(Database* db, Q3Range* ranges, size_t count);
+
+#endif
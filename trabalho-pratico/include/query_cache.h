@@ -0,0 +1,37 @@
+#ifndef TRABALHO_PRATICO_QUERY_CACHE_H
+#define TRABALHO_PRATICO_QUERY_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Query results by normalized query text: the exact bytes a query wrote,
+// replayed when the same query comes again. Each entry carries the data
+// version it was computed at (supplied by the caller); a lookup at another
+// version drops the entry instead of returning it.
+typedef struct query_cache QueryCache;
+
+typedef struct {
+    size_t lookups;
+    size_t hits;
+    size_t invalidations;      // entries dropped because the data changed
+} QueryCacheStats;
+
+// Keeps at most `max_bytes` of entries (replaced entries included until
+// then); when full the cache is emptied and refilled from there
+QueryCache* query_cache_create(size_t max_bytes);
+void query_cache_destroy(QueryCache* cache);
+
+// Output stored for `key` at `version` (borrowed until the next call that
+// changes the cache). False on a miss.
+bool query_cache_get(QueryCache* cache, const char* key, uint64_t version,
+                     const char** output, size_t* length);
+
+// Stores (or replaces) the output of `key`, computed at `version`. Outputs
+// that do not fit are not stored.
+void query_cache_put(QueryCache* cache, const char* key, uint64_t version,
+                     const char* output, size_t length);
+
+QueryCacheStats query_cache_stats(const QueryCache* cache);
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef TRABALHO_PRATICO_QUERY_PLAN_H
+#define TRABALHO_PRATICO_QUERY_PLAN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <time.h>
+
+// A query line parsed once into typed arguments: executing it (again, in
+// a batch or on another thread) does no text parsing. The arguments are
+// read exactly as the handlers always read them.
+typedef struct {
+    bool empty;                    // the line holds no query (only spaces)
+    int number;                    // query number as written (atoi of the first word)
+    const char* line;              // the line as read (not owned)
+    union {
+        struct {
+            const char* code;      // airport code as written, inside `line` (NULL if absent)
+            size_t length;
+        } q1;
+        struct {
+            int n;                 // 0 if it cannot be read
+            char manufacturer[128];    // "" for every manufacturer
+        } q2;
+        struct {
+            bool valid;            // false if a date is missing or invalid
+            time_t from;           // midnight of the earlier day
+            time_t to;             // last second of the later day
+        } q3;
+    } args;
+} CompiledQuery;
+
+// Parses `line` (up to its first newline or 255 characters) into `query`,
+// which keeps pointing into `line`. False if the line holds no query.
+bool query_compile(const char* line, CompiledQuery* query);
+
+// Canonical text of a Q1-Q3 query: queries with the same text have the
+// same answer on the same data (e.g. Q3 dates given in either order)
+void query_canonical(const CompiledQuery* query, char* text, size_t size);
+
+// Every query of an input file, compiled up front. Lines are read as the
+// program reads them, 255 characters at most, and empty lines are skipped.
+typedef struct query_plan QueryPlan;
+
+QueryPlan* query_plan_read(FILE* input);
+void query_plan_destroy(QueryPlan* plan);
+
+size_t query_plan_count(const QueryPlan* plan);
+const CompiledQuery* query_plan_get(const QueryPlan* plan, size_t index);
+
+#endif
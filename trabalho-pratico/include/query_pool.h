@@ -0,0 +1,22 @@
+#ifndef TRABALHO_PRATICO_QUERY_POOL_H
+#define TRABALHO_PRATICO_QUERY_POOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Worker pool for independent queries: workers take the next query index
+// as they become free, while the calling thread reports completions in
+// index order (query i is reported once queries 0..i have all finished).
+
+typedef void (*QueryPoolTask)(void* context, size_t index);
+
+// Number of worker threads worth starting for `count` queries on this
+// machine (0: run them on the calling thread)
+int query_pool_workers(size_t count);
+
+// Runs run(context, i) on the workers and finished(context, i) on the
+// calling thread, for every i < count. Returns false, having run nothing,
+// if the threads could not be started.
+bool query_pool_run(size_t count, int workers, QueryPoolTask run, QueryPoolTask finished, void* context);
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef TRABALHO_PRATICO_REJECT_LOG_H
+#define TRABALHO_PRATICO_REJECT_LOG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <sys/types.h>
+
+// Batched writer for rejected rows. Rows are recorded as byte ranges of the
+// source file and written later, straight from the reader's buffer, with
+// gathered writes (no per-row formatting or copy).
+typedef struct reject_log RejectLog;
+
+// Lifecycle (output is flushed and then written through its descriptor)
+RejectLog* reject_log_create(FILE* output);
+void reject_log_destroy(RejectLog* log);
+
+// Records the row at [offset, offset + length) of the source file; the
+// newline, if any, is not part of the range
+void reject_log_record(RejectLog* log, off_t offset, size_t length, bool had_newline);
+
+// True when enough rows are pending that they should be written now
+bool reject_log_full(const RejectLog* log);
+
+// Writes every pending row; `buffer` holds the source bytes starting at
+// file offset `buffer_offset` and must cover all pending ranges
+void reject_log_flush(RejectLog* log, const char* buffer, off_t buffer_offset);
+
+#endif
@@ -3,16 +3,20 @@
 
 #include <stddef.h>
 #include <stdbool.h>
+#include "flights.h"
+
+#define RESERVATION_MAX_FLIGHTS 2
 
 typedef struct reservation Reservation;
 
 // criar e destruir
-Reservation *reservation_create(const char *id, const char **flight_ids, const char *document_number, const char *seat, double price, bool extra_luggage, bool priority_boarding, const char *qr_code, size_t flight_count);
+Reservation *reservation_create(const char *id, Flight *const *flights, const char *document_number, const char *seat, double price, bool extra_luggage, bool priority_boarding, const char *qr_code, size_t flight_count);
 void reservation_destroy(Reservation *reservation);
 
 // getters
 const char *reservation_get_id(const Reservation *reservation);
 const char *reservation_get_flight_id(const Reservation *reservation, size_t index);
+const Flight *reservation_get_flight(const Reservation *reservation, size_t index);
 const char *reservation_get_document_number(const Reservation *reservation);
 const char *reservation_get_seat(const Reservation *reservation);
 double reservation_get_price(const Reservation *reservation);
@@ -0,0 +1,39 @@
+#ifndef TRABALHO_PRATICO_SCRATCH_ARENA_H
+#define TRABALHO_PRATICO_SCRATCH_ARENA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Bump allocator for memory that lives until the next reset. Chunks are
+// kept across resets, and a reset after an overflow replaces them with one
+// chunk as large as everything used since: once the arena has grown to the
+// size a round needs, allocating from it never reaches the heap.
+typedef struct scratch_arena ScratchArena;
+
+ScratchArena* scratch_arena_create(size_t initial_size);
+void scratch_arena_destroy(ScratchArena* arena);
+
+// `size` bytes, aligned for any type, valid until the next reset. NULL if
+// memory runs out.
+void* scratch_alloc(ScratchArena* arena, size_t size);
+
+// Whether `size` bytes can be allocated without growing the arena
+bool scratch_fits(const ScratchArena* arena, size_t size);
+
+// Releases every allocation at once
+void scratch_reset(ScratchArena* arena);
+
+// Text growing inside an arena, e.g. a query's output
+typedef struct {
+    ScratchArena* arena;
+    char* data;                    // NUL-terminated (NULL until something is appended)
+    size_t length;
+    size_t capacity;
+    bool failed;                   // an append did not fit in memory; the text is truncated
+} ScratchText;
+
+void scratch_text_init(ScratchText* text, ScratchArena* arena);
+void scratch_text_printf(ScratchText* text, const char* format, ...)
+    __attribute__((format(printf, 2, 3)));
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef TRABALHO_PRATICO_SPSC_RING_H
+#define TRABALHO_PRATICO_SPSC_RING_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Bounded lock-free ring of pointers for exactly one producer thread and
+// one consumer thread
+typedef struct {
+    _Alignas(64) atomic_size_t head;     // next slot to pop (consumer)
+    _Alignas(64) atomic_size_t tail;     // next slot to push (producer)
+    _Alignas(64) size_t mask;            // capacity - 1 (capacity is a power of two)
+    void** slots;
+} SpscRing;
+
+// Lifecycle: capacity is rounded up to a power of two
+bool spsc_ring_init(SpscRing* ring, size_t capacity);
+void spsc_ring_destroy(SpscRing* ring);
+
+// Non-blocking: false if the ring is full / empty
+bool spsc_ring_try_push(SpscRing* ring, void* item);
+bool spsc_ring_try_pop(SpscRing* ring, void** item);
+
+// Blocking (spin, then yield, then sleep): a full ring stalls the producer,
+// which is what bounds the memory of a pipeline
+void spsc_ring_push(SpscRing* ring, void* item);
+void* spsc_ring_pop(SpscRing* ring);
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef TESTES_VALIDADORES_H
+#define TESTES_VALIDADORES_H
+
+// Compara os validadores de parser_utils com as implementações de referência
+// sobre entradas pseudo-aleatórias. Devolve o número de divergências.
+int run_validators_differential_test(unsigned iterations, unsigned seed);
+
+#endif // TESTES_VALIDADORES_H
@@ -0,0 +1,31 @@
+#ifndef TRABALHO_PRATICO_TOP_K_H
+#define TRABALHO_PRATICO_TOP_K_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Top-k selection over packed 64-bit sort keys, smallest first. Ranking
+// criteria are folded into the key up front (see top_k_pack), so the
+// selection only compares integers: no entity pointers are followed and
+// no strcmp is called.
+//
+// Small k uses a bounded max-heap over one pass (n log k); larger k uses
+// introselect (quickselect falling back to heap selection when the
+// partitions degrade) followed by a sort of the k survivors.
+//
+// No query uses it yet: it is only linked into programa-testes, for the
+// top-k benchmark.
+
+// Key ranking by `count` descending, then `tiebreak` ascending. The
+// tiebreak must encode the entity's order (e.g. a numeric id or a
+// position in an id-sorted array) and can be recovered with
+// top_k_tiebreak.
+uint64_t top_k_pack(uint32_t count, uint32_t tiebreak);
+uint32_t top_k_count(uint64_t key);
+uint32_t top_k_tiebreak(uint64_t key);
+
+// Moves the min(k, n) smallest keys to keys[0..), in ascending order; the
+// rest of the array is left in unspecified order. Returns min(k, n).
+size_t top_k_select(uint64_t* keys, size_t n, size_t k);
+
+#endif
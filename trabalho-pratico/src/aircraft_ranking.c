@@ -0,0 +1,100 @@
+#include "../include/aircraft_ranking.h"
+#include "../include/aircrafts.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    const char* manufacturer;
+    size_t start;              // its slice of by_manufacturer
+    size_t count;
+} ManufacturerSlice;
+
+typedef struct aircraft_ranking {
+    Aircraft** ranked;             // all aircrafts, ranked
+    Aircraft** by_manufacturer;    // grouped by manufacturer, ranked within each group
+    size_t aircraft_count;
+    ManufacturerSlice* manufacturers;  // sorted by name
+    size_t manufacturer_count;
+} AircraftRanking;
+
+// Flight count (descending), then ID (ascending)
+static int compare_rank(const Aircraft* a, const Aircraft* b) {
+    int count_a = aircraft_get_flight_count(a);
+    int count_b = aircraft_get_flight_count(b);
+    if (count_a != count_b) return count_a > count_b ? -1 : 1;
+    return strcmp(aircraft_get_id(a), aircraft_get_id(b));
+}
+
+static int compare_ranked(const void* a, const void* b) {
+    return compare_rank(*(Aircraft* const*)a, *(Aircraft* const*)b);
+}
+
+static int compare_grouped(const void* a, const void* b) {
+    int by_name = strcmp(aircraft_get_manufacturer(*(Aircraft* const*)a),
+                         aircraft_get_manufacturer(*(Aircraft* const*)b));
+    return by_name ? by_name : compare_ranked(a, b);
+}
+
+AircraftRanking* aircraft_ranking_build(Database* db) {
+    AircraftRanking* ranking = calloc(1, sizeof(AircraftRanking));
+    if (!ranking) return NULL;
+    
+    ranking->ranked = database_get_all_aircrafts(db, &ranking->aircraft_count);
+    if (ranking->aircraft_count == 0) return ranking;
+    
+    size_t n = ranking->aircraft_count;
+    ranking->by_manufacturer = malloc(n * sizeof(Aircraft*));
+    ranking->manufacturers = malloc(n * sizeof(ManufacturerSlice));
+    if (!ranking->ranked || !ranking->by_manufacturer || !ranking->manufacturers) {
+        aircraft_ranking_destroy(ranking);
+        return NULL;
+    }
+    
+    qsort(ranking->ranked, n, sizeof(Aircraft*), compare_ranked);
+    memcpy(ranking->by_manufacturer, ranking->ranked, n * sizeof(Aircraft*));
+    qsort(ranking->by_manufacturer, n, sizeof(Aircraft*), compare_grouped);
+    
+    // Groups are contiguous and already in name order
+    for (size_t i = 0; i < n; i++) {
+        const char* manufacturer = aircraft_get_manufacturer(ranking->by_manufacturer[i]);
+        ManufacturerSlice* last = ranking->manufacturer_count ?
+                                  &ranking->manufacturers[ranking->manufacturer_count - 1] : NULL;
+        if (last && strcmp(last->manufacturer, manufacturer) == 0) {
+            last->count++;
+        } else {
+            ranking->manufacturers[ranking->manufacturer_count++] = (ManufacturerSlice){ manufacturer, i, 1 };
+        }
+    }
+    return ranking;
+}
+
+void aircraft_ranking_destroy(AircraftRanking* ranking) {
+    if (!ranking) return;
+    free(ranking->ranked);
+    free(ranking->by_manufacturer);
+    free(ranking->manufacturers);
+    free(ranking);
+}
+
+Aircraft* const* aircraft_ranking_get(const AircraftRanking* ranking, const char* manufacturer, size_t* count) {
+    *count = 0;
+    if (!ranking || ranking->aircraft_count == 0) return NULL;
+    
+    if (!manufacturer) {
+        *count = ranking->aircraft_count;
+        return ranking->ranked;
+    }
+    
+    size_t lo = 0, hi = ranking->manufacturer_count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        int cmp = strcmp(ranking->manufacturers[mid].manufacturer, manufacturer);
+        if (cmp == 0) {
+            *count = ranking->manufacturers[mid].count;
+            return ranking->by_manufacturer + ranking->manufacturers[mid].start;
+        }
+        if (cmp < 0) lo = mid + 1;
+        else hi = mid;
+    }
+    return NULL;
+}
@@ -0,0 +1,246 @@
+#include "../include/benchmark_ingestao.h"
+#include "../include/database.h"
+#include "../include/ingestor.h"
+#include "../include/live_ingest.h"
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Duração de cada ritmo de escrita
+#define BENCH_SECONDS 0.5
+
+static const int BENCH_RATES[] = { 100, 1000, 10000 };   // linhas por segundo
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void sleep_until(double t) {
+    double remaining = t - now_seconds();
+    if (remaining <= 0) return;
+    struct timespec ts = { (time_t)remaining, (long)((remaining - (time_t)remaining) * 1e9) };
+    nanosleep(&ts, NULL);
+}
+
+static int copy_file(const char* from, const char* to) {
+    FILE* in = fopen(from, "rb");
+    if (!in) return -1;
+    FILE* out = fopen(to, "wb");
+    if (!out) {
+        fclose(in);
+        return -1;
+    }
+    char buffer[65536];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), in)) > 0) fwrite(buffer, 1, n, out);
+    fclose(in);
+    fclose(out);
+    return 0;
+}
+
+static int write_file(const char* path, const char* content) {
+    FILE* f = fopen(path, "w");
+    if (!f) return -1;
+    fputs(content, f);
+    fclose(f);
+    return 0;
+}
+
+// Escritor: acrescenta `count` voos a flights.csv ao ritmo pedido e regista
+// o instante de cada escrita antes de a publicar
+typedef struct {
+    const char* flights_path;
+    const char* origin;
+    const char* destination;
+    const char* aircraft;
+    int first_id;
+    int count;
+    int rate;
+    double* write_times;
+    atomic_int published;
+} Appender;
+
+static void format_flight_id(char* id, int n) {
+    snprintf(id, 8, "BM%05d", n);
+}
+
+static void* append_flights(void* arg) {
+    Appender* app = arg;
+    int fd = open(app->flights_path, O_WRONLY | O_APPEND);
+    if (fd < 0) {
+        atomic_store(&app->published, -1);
+        return NULL;
+    }
+    
+    double start = now_seconds();
+    for (int i = 0; i < app->count; i++) {
+        sleep_until(start + (double)i / app->rate);
+        
+        char id[8];
+        char row[256];
+        format_flight_id(id, app->first_id + i);
+        int len = snprintf(row, sizeof(row),
+            "\"%s\",\"2024-01-01 10:00\",\"2024-01-01 10:00\",\"2024-01-01 12:00\",\"2024-01-01 12:00\","
+            "\"G1\",\"On Time\",\"%s\",\"%s\",\"%s\",\"Bench\",\"https://t/b\"\n",
+            id, app->origin, app->destination, app->aircraft);
+        
+        app->write_times[i] = now_seconds();
+        if (write(fd, row, (size_t)len) != len) break;
+        atomic_store(&app->published, i + 1);
+    }
+    close(fd);
+    return NULL;
+}
+
+static int compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Um ritmo: o escritor corre numa thread, esta thread consulta a base de
+// dados até cada voo aparecer
+static int measure_rate(Database* db, LiveIngest* live, Appender* app, double* latencies) {
+    pthread_t writer;
+    atomic_store(&app->published, 0);
+    if (pthread_create(&writer, NULL, append_flights, app) != 0) return -1;
+    
+    const struct timespec poll_interval = { 0, 20000 };   // 20 us
+    for (int next = 0; next < app->count; ) {
+        int published = atomic_load(&app->published);
+        if (published < 0) break;
+        if (next >= published) {
+            nanosleep(&poll_interval, NULL);
+            continue;
+        }
+        
+        char id[8];
+        format_flight_id(id, app->first_id + next);
+        live_ingest_read_begin(live);
+        bool visible = database_get_flight(db, id) != NULL;
+        live_ingest_read_end(live);
+        
+        if (visible) {
+            latencies[next] = now_seconds() - app->write_times[next];
+            next++;
+        } else {
+            nanosleep(&poll_interval, NULL);
+        }
+    }
+    
+    pthread_join(writer, NULL);
+    return atomic_load(&app->published) == app->count ? 0 : -1;
+}
+
+int run_live_ingest_benchmark(const char* dataset_path) {
+    printf("=== Latencia de ingestao (--live) ===\n");
+    
+    char dir[] = "/tmp/benchmark-ingestao-XXXXXX";
+    if (!mkdtemp(dir)) {
+        fprintf(stderr, "Erro ao criar pasta temporaria\n");
+        return -1;
+    }
+    
+    // Dataset temporário: aeroportos e aeronaves reais, restantes tabelas vazias
+    const char* tables[] = { "airports", "aircrafts", "passengers", "flights", "reservations" };
+    char paths[5][600];
+    char source[600];
+    for (int t = 0; t < 5; t++) {
+        snprintf(paths[t], sizeof(paths[t]), "%s/%s.csv", dir, tables[t]);
+    }
+    snprintf(source, sizeof(source), "%s/airports.csv", dataset_path);
+    int status = copy_file(source, paths[0]);
+    snprintf(source, sizeof(source), "%s/aircrafts.csv", dataset_path);
+    if (status == 0) status = copy_file(source, paths[1]);
+    if (status == 0) status = write_file(paths[2], "\"document_number\",\"first_name\",\"last_name\",\"dob\",\"nationality\",\"gender\",\"email\",\"phone\",\"address\",\"photo\"\n");
+    if (status == 0) status = write_file(paths[3], "\"id\",\"departure\",\"actual_departure\",\"arrival\",\"actual_arrival\",\"gate\",\"status\",\"origin\",\"destination\",\"aircraft\",\"airline\",\"tracking_url\"\n");
+    if (status == 0) status = write_file(paths[4], "\"id\",\"flight_ids\",\"document_number\",\"seat\",\"price\",\"extra_luggage\",\"priority_boarding\",\"qr_code\"\n");
+    
+    // As mensagens de progresso da ingestão não interessam aqui
+    fflush(stdout);
+    int saved_stdout = dup(STDOUT_FILENO);
+    int devnull = open("/dev/null", O_WRONLY);
+    if (saved_stdout >= 0 && devnull >= 0) dup2(devnull, STDOUT_FILENO);
+    
+    Database* db = database_create();
+    Ingestor* ingestor = status == 0 && db ? ingestor_create(dir, dir, db, true) : NULL;
+    if (ingestor) ingestor_load_all(ingestor);
+    
+    size_t airport_count = 0, aircraft_count = 0;
+    Airport** airports = db ? database_get_all_airports(db, &airport_count) : NULL;
+    Aircraft** aircrafts = db ? database_get_all_aircrafts(db, &aircraft_count) : NULL;
+    LiveIngest* live = ingestor && airport_count >= 2 && aircraft_count >= 1 ?
+                       live_ingest_start(ingestor, dir) : NULL;
+    
+    int total = 0;
+    for (size_t r = 0; r < sizeof(BENCH_RATES) / sizeof(BENCH_RATES[0]); r++) {
+        total += (int)(BENCH_RATES[r] * BENCH_SECONDS);
+    }
+    double* write_times = malloc(sizeof(double) * (size_t)total);
+    double* latencies = malloc(sizeof(double) * (size_t)total);
+    
+    char report[1024] = "";
+    size_t report_len = 0;
+    if (live && write_times && latencies) {
+        Appender app = {
+            .flights_path = paths[3],
+            .origin = airport_get_code(airports[0]),
+            .destination = airport_get_code(airports[1]),
+            .aircraft = aircraft_get_id(aircrafts[0]),
+            .first_id = 0,
+            .write_times = write_times,
+        };
+        
+        for (size_t r = 0; r < sizeof(BENCH_RATES) / sizeof(BENCH_RATES[0]) && status == 0; r++) {
+            app.rate = BENCH_RATES[r];
+            app.count = (int)(app.rate * BENCH_SECONDS);
+            status = measure_rate(db, live, &app, latencies);
+            if (status != 0) break;
+            
+            qsort(latencies, (size_t)app.count, sizeof(double), compare_doubles);
+            report_len += (size_t)snprintf(report + report_len, sizeof(report) - report_len,
+                "%6d linhas/s: p50 %.3f ms, p99 %.3f ms, max %.3f ms (%d linhas)\n",
+                app.rate, latencies[app.count / 2] * 1e3,
+                latencies[(app.count * 99) / 100] * 1e3, latencies[app.count - 1] * 1e3, app.count);
+            app.first_id += app.count;
+        }
+    } else {
+        status = -1;
+    }
+    
+    live_ingest_stop(live);
+    ingestor_destroy(ingestor);
+    free(airports);
+    free(aircrafts);
+    database_destroy(db);
+    free(write_times);
+    free(latencies);
+    
+    fflush(stdout);
+    if (saved_stdout >= 0) {
+        dup2(saved_stdout, STDOUT_FILENO);
+        close(saved_stdout);
+    }
+    if (devnull >= 0) close(devnull);
+    
+    for (int t = 0; t < 5; t++) {
+        unlink(paths[t]);
+        char error_path[620];
+        snprintf(error_path, sizeof(error_path), "%s/%s_errors.csv", dir, tables[t]);
+        unlink(error_path);
+    }
+    rmdir(dir);
+    
+    if (status != 0) {
+        fprintf(stderr, "Erro no benchmark de ingestao\n");
+        return -1;
+    }
+    printf("%s", report);
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include "../include/benchmark_topk.h"
+#include "../include/top_k.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static const size_t BENCH_KS[] = { 1, 10, 1000 };
+
+// Candidato ao estilo das entidades: contagem e identificador em texto
+typedef struct {
+    int count;
+    char id[24];
+} Candidato;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Mesmo critério que as queries: contagem decrescente, depois id crescente
+static int comparar_candidatos(const void* a, const void* b) {
+    const Candidato* ca = *(Candidato* const*)a;
+    const Candidato* cb = *(Candidato* const*)b;
+    if (ca->count != cb->count) return cb->count - ca->count;
+    return strcmp(ca->id, cb->id);
+}
+
+int run_topk_benchmark(size_t candidates, unsigned seed) {
+    Candidato* todos = malloc(candidates * sizeof(Candidato));
+    Candidato** apontadores = malloc(candidates * sizeof(Candidato*));
+    uint64_t* chaves = malloc(candidates * sizeof(uint64_t));
+    if (!todos || !apontadores || !chaves) {
+        fprintf(stderr, "Erro ao reservar memoria para o benchmark de top-k\n");
+        free(todos);
+        free(apontadores);
+        free(chaves);
+        return 1;
+    }
+    
+    // Ids com largura fixa: a ordem do texto é a ordem do número, que é o
+    // desempate codificado na chave. Contagens com muitos empates.
+    srand(seed);
+    for (size_t i = 0; i < candidates; i++) {
+        todos[i].count = rand() % 5000;
+        snprintf(todos[i].id, sizeof(todos[i].id), "AC%07zu", i);
+    }
+    
+    printf("=== Top-k vs qsort (%zu candidatos) ===\n", candidates);
+    int divergencias = 0;
+    for (size_t t = 0; t < sizeof(BENCH_KS) / sizeof(BENCH_KS[0]); t++) {
+        size_t k = BENCH_KS[t];
+        
+        double inicio = now_seconds();
+        for (size_t i = 0; i < candidates; i++) apontadores[i] = &todos[i];
+        qsort(apontadores, candidates, sizeof(Candidato*), comparar_candidatos);
+        double tempo_qsort = now_seconds() - inicio;
+        
+        inicio = now_seconds();
+        for (size_t i = 0; i < candidates; i++) chaves[i] = top_k_pack((uint32_t)todos[i].count, (uint32_t)i);
+        size_t obtidos = top_k_select(chaves, candidates, k);
+        double tempo_topk = now_seconds() - inicio;
+        
+        for (size_t i = 0; i < obtidos; i++) {
+            if (&todos[top_k_tiebreak(chaves[i])] != apontadores[i]) {
+                if (divergencias++ < 5) {
+                    printf("Divergencia em k=%zu, posicao %zu: esperado %s, obtido %s\n",
+                           k, i, apontadores[i]->id, todos[top_k_tiebreak(chaves[i])].id);
+                }
+            }
+        }
+        printf("k=%-5zu qsort %8.3f ms   top-k %8.3f ms   (%.1fx)\n",
+               k, tempo_qsort * 1000, tempo_topk * 1000, tempo_qsort / (tempo_topk > 0 ? tempo_topk : 1e-9));
+    }
+    printf("Divergencias: %d\n", divergencias);
+    
+    free(todos);
+    free(apontadores);
+    free(chaves);
+    return divergencias;
+}
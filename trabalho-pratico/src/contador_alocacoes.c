@@ -0,0 +1,38 @@
+#include "../include/contador_alocacoes.h"
+
+// Implementações da glibc, para onde as funções abaixo delegam
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t count, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+extern void __libc_free(void* ptr);
+
+static size_t alocacoes = 0;
+static size_t libertacoes = 0;
+
+void* malloc(size_t size) {
+    __atomic_fetch_add(&alocacoes, 1, __ATOMIC_RELAXED);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+    __atomic_fetch_add(&alocacoes, 1, __ATOMIC_RELAXED);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) {
+    __atomic_fetch_add(&alocacoes, 1, __ATOMIC_RELAXED);
+    return __libc_realloc(ptr, size);
+}
+
+void free(void* ptr) {
+    if (ptr) __atomic_fetch_add(&libertacoes, 1, __ATOMIC_RELAXED);
+    __libc_free(ptr);
+}
+
+size_t contador_alocacoes(void) {
+    return __atomic_load_n(&alocacoes, __ATOMIC_RELAXED);
+}
+
+size_t contador_libertacoes(void) {
+    return __atomic_load_n(&libertacoes, __ATOMIC_RELAXED);
+}
@@ -3,79 +3,308 @@
 #include "../include/airports.h"
 #include "../include/aircrafts.h"
 #include "../include/flights.h"
-#include "../include/parser_utils.h"
+#include "../include/departure_index.h"
+#include "../include/q3_batch.h"
+#include "../include/aircraft_ranking.h"
+#include "../include/index_manager.h"
+#include "../include/query_cache.h"
+#include "../include/scratch_arena.h"
+#include <pthread.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
+#define QUERY_CACHE_BYTES (16u << 20)
+#define SCRATCH_BYTES (64 * 1024)
+#define IDLE_SCRATCH_SLOTS 8           // one per worker of the query pool
+
 typedef struct controller {
     Database* db;
+    IndexManager* indexes;         // structures built for the queries, on first use
+    int ranking_index;             // AircraftRanking: Q2 rankings
+    int departures_index;          // DepartureIndex: Q3 departure times per airport
+    int planned_index;             // PlannedRanges: the planned Q3 ranges, evaluated
+    Q3Range* planned;              // Q3 ranges announced by controller_plan_query
+    size_t planned_count;
+    size_t planned_capacity;
+    QueryCache* cache;             // outputs by normalized query (NULL: every query is computed)
+    ScratchArena** idle_scratch;   // arenas not in use by a query, reset
+    size_t idle_count;
+    size_t idle_capacity;
+    pthread_mutex_t lock;          // guards the departure day aggregate
+    pthread_mutex_t cache_lock;
+    pthread_mutex_t scratch_lock;
 } Controller;
 
-// Forward declarations for query handlers
-static void execute_query1(Controller* ctrl, const char* arg, FILE* output);
-static void execute_query2(Controller* ctrl, const char* arg, FILE* output);
-static void execute_query3(Controller* ctrl, const char* arg, FILE* output);
+// Query handlers, registered in query_handlers below
+static void execute_query1(Controller* ctrl, const CompiledQuery* query, ScratchText* output);
+static void execute_query2(Controller* ctrl, const CompiledQuery* query, ScratchText* output);
+static void execute_query3(Controller* ctrl, const CompiledQuery* query, ScratchText* output);
+
+typedef struct {
+    int number;
+    unsigned tables;               // INGEST_* bits of the tables the query reads
+    void (*execute)(Controller* ctrl, const CompiledQuery* query, ScratchText* output);
+} QueryHandler;
+
+static const QueryHandler query_handlers[] = {
+    { 1, INGEST_AIRPORTS, execute_query1 },
+    // Flight counts are accumulated while flights are loaded
+    { 2, INGEST_AIRCRAFTS | INGEST_FLIGHTS, execute_query2 },
+    { 3, INGEST_AIRPORTS | INGEST_FLIGHTS, execute_query3 },
+};
+
+static const QueryHandler* find_handler(int number) {
+    for (size_t i = 0; i < sizeof(query_handlers) / sizeof(query_handlers[0]); i++) {
+        if (query_handlers[i].number == number) return &query_handlers[i];
+    }
+    return NULL;
+}
+
+// Planned Q3 ranges, sorted, with their results
+typedef struct {
+    Q3Range* ranges;
+    size_t count;
+} PlannedRanges;
+
+static int compare_ranges(const void* a, const void* b) {
+    const Q3Range* ra = a;
+    const Q3Range* rb = b;
+    if (ra->from != rb->from) return (ra->from > rb->from) - (ra->from < rb->from);
+    return (ra->to > rb->to) - (ra->to < rb->to);
+}
+
+// Index builders, registered with the index manager in controller_create
+static void* build_ranking(Database* db, void* context) {
+    (void)context;
+    return aircraft_ranking_build(db);
+}
+
+static void destroy_ranking(void* index) {
+    aircraft_ranking_destroy(index);
+}
+
+static size_t ranking_cost(Database* db, void* context) {
+    (void)context;
+    return database_count_aircrafts(db);
+}
+
+static void* build_departures(Database* db, void* context) {
+    (void)context;
+    return departure_index_build(db);
+}
+
+static void destroy_departures(void* index) {
+    departure_index_destroy(index);
+}
+
+static size_t departures_cost(Database* db, void* context) {
+    (void)context;
+    return database_count_flights(db);
+}
+
+// Every planned range evaluated in one sweep through the flights
+static void* build_planned(Database* db, void* context) {
+    Controller* ctrl = context;
+    if (ctrl->planned_count == 0) return NULL;
+    
+    PlannedRanges* planned = malloc(sizeof(PlannedRanges));
+    if (!planned) return NULL;
+    planned->count = ctrl->planned_count;
+    planned->ranges = malloc(planned->count * sizeof(Q3Range));
+    if (!planned->ranges) {
+        free(planned);
+        return NULL;
+    }
+    memcpy(planned->ranges, ctrl->planned, planned->count * sizeof(Q3Range));
+    qsort(planned->ranges, planned->count, sizeof(Q3Range), compare_ranges);
+    if (!q3_batch_evaluate(db, planned->ranges, planned->count)) {
+        free(planned->ranges);      // answered one by one instead
+        free(planned);
+        return NULL;
+    }
+    return planned;
+}
+
+static void destroy_planned(void* index) {
+    PlannedRanges* planned = index;
+    free(planned->ranges);
+    free(planned);
+}
+
+static size_t planned_cost(Database* db, void* context) {
+    const Controller* ctrl = context;
+    return database_count_flights(db) + ctrl->planned_count * database_count_airports(db);
+}
 
 Controller* controller_create(Database* db) {
     Controller* ctrl = malloc(sizeof(Controller));
     if (!ctrl) return NULL;
     ctrl->db = db;
+    ctrl->indexes = index_manager_create(db);
+    if (!ctrl->indexes) {
+        free(ctrl);
+        return NULL;
+    }
+    const IndexSpec ranking = {
+        "Q2 ranking", INGEST_AIRCRAFTS | INGEST_FLIGHTS, build_ranking, destroy_ranking, ranking_cost, NULL
+    };
+    const IndexSpec departures = {
+        "Q3 departure times", INGEST_AIRPORTS | INGEST_FLIGHTS, build_departures, destroy_departures,
+        departures_cost, NULL
+    };
+    const IndexSpec planned = {
+        "Q3 planned ranges", INGEST_AIRPORTS | INGEST_FLIGHTS, build_planned, destroy_planned,
+        planned_cost, ctrl
+    };
+    ctrl->ranking_index = index_manager_register(ctrl->indexes, &ranking);
+    ctrl->departures_index = index_manager_register(ctrl->indexes, &departures);
+    ctrl->planned_index = index_manager_register(ctrl->indexes, &planned);
+    ctrl->planned = NULL;
+    ctrl->planned_count = 0;
+    ctrl->planned_capacity = 0;
+    ctrl->cache = query_cache_create(QUERY_CACHE_BYTES);
+    ctrl->idle_scratch = malloc(IDLE_SCRATCH_SLOTS * sizeof(ScratchArena*));
+    ctrl->idle_capacity = ctrl->idle_scratch ? IDLE_SCRATCH_SLOTS : 0;
+    ctrl->idle_count = 0;
+    if (ctrl->idle_scratch) {
+        ScratchArena* scratch = scratch_arena_create(SCRATCH_BYTES);
+        if (scratch) ctrl->idle_scratch[ctrl->idle_count++] = scratch;
+    }
+    pthread_mutex_init(&ctrl->lock, NULL);
+    pthread_mutex_init(&ctrl->cache_lock, NULL);
+    pthread_mutex_init(&ctrl->scratch_lock, NULL);
     return ctrl;
 }
 
 void controller_destroy(Controller* ctrl) {
-    if (ctrl) free(ctrl);
+    if (!ctrl) return;
+    index_manager_destroy(ctrl->indexes);   // joins a background build first
+    free(ctrl->planned);
+    query_cache_destroy(ctrl->cache);
+    for (size_t i = 0; i < ctrl->idle_count; i++) scratch_arena_destroy(ctrl->idle_scratch[i]);
+    free(ctrl->idle_scratch);
+    pthread_mutex_destroy(&ctrl->lock);
+    pthread_mutex_destroy(&ctrl->cache_lock);
+    pthread_mutex_destroy(&ctrl->scratch_lock);
+    free(ctrl);
+}
+
+// Scratch memory for one query: an idle arena, or a new one when every
+// arena is in use by a concurrent query
+static ScratchArena* take_scratch(Controller* ctrl) {
+    pthread_mutex_lock(&ctrl->scratch_lock);
+    ScratchArena* scratch = ctrl->idle_count > 0 ? ctrl->idle_scratch[--ctrl->idle_count] : NULL;
+    pthread_mutex_unlock(&ctrl->scratch_lock);
+    return scratch ? scratch : scratch_arena_create(SCRATCH_BYTES);
+}
+
+static void release_scratch(Controller* ctrl, ScratchArena* scratch) {
+    scratch_reset(scratch);
+    pthread_mutex_lock(&ctrl->scratch_lock);
+    if (ctrl->idle_count == ctrl->idle_capacity) {
+        size_t capacity = ctrl->idle_capacity ? ctrl->idle_capacity * 2 : IDLE_SCRATCH_SLOTS;
+        ScratchArena** grown = realloc(ctrl->idle_scratch, capacity * sizeof(ScratchArena*));
+        if (grown) {
+            ctrl->idle_scratch = grown;
+            ctrl->idle_capacity = capacity;
+        }
+    }
+    if (ctrl->idle_count < ctrl->idle_capacity) {
+        ctrl->idle_scratch[ctrl->idle_count++] = scratch;
+        scratch = NULL;
+    }
+    pthread_mutex_unlock(&ctrl->scratch_lock);
+    scratch_arena_destroy(scratch);
 }
 
 int controller_execute_query(Controller* ctrl, const char* query_line, FILE* output) {
     if (!ctrl || !query_line || !output) return -1;
     
-    char line[256];
-    strncpy(line, query_line, sizeof(line) - 1);
-    line[sizeof(line) - 1] = '\0';
-    line[strcspn(line, "\n")] = 0;
-    
-    // Parse query number and arguments
-    char* query_num_str = strtok(line, " ");
-    char* arg = strtok(NULL, "");
-    
-    if (!query_num_str) return -1;
+    CompiledQuery query;
+    query_compile(query_line, &query);
+    return controller_execute_compiled(ctrl, &query, output);
+}
+
+int controller_execute_compiled(Controller* ctrl, const CompiledQuery* query, FILE* output) {
+    if (!ctrl || !query || !output || query->empty) return -1;
     
-    int query_num = atoi(query_num_str);
+    const QueryHandler* handler = find_handler(query->number);
+    if (!handler) {
+        fprintf(stderr, "Unknown query: %d\n", query->number);
+        return -1;
+    }
     
-    switch (query_num) {
-        case 1:
-            execute_query1(ctrl, arg, output);
-            break;
-        case 2:
-            execute_query2(ctrl, arg, output);
-            break;
-        case 3:
-            execute_query3(ctrl, arg, output);
-            break;
-        default:
-            fprintf(stderr, "Unknown query: %d\n", query_num);
-            return -1;
+    // Cached by canonical text, valid while the tables it reads keep their rows
+    char key[320];
+    query_canonical(query, key, sizeof(key));
+    uint64_t version = ingestor_count_rows(ctrl->db, handler->tables);
+    
+    const char* cached;
+    size_t length;
+    pthread_mutex_lock(&ctrl->cache_lock);
+    bool hit = query_cache_get(ctrl->cache, key, version, &cached, &length);
+    if (hit) fwrite(cached, 1, length, output);
+    pthread_mutex_unlock(&ctrl->cache_lock);
+    if (hit) return 0;
+    
+    // Rendered into the query's scratch arena, so the exact bytes can be
+    // kept for the next time; the arena is reset afterwards
+    ScratchArena* scratch = take_scratch(ctrl);
+    if (!scratch) {
+        fprintf(stderr, "Out of memory for query: %d\n", query->number);
+        return -1;
     }
+    ScratchText rendered;
+    scratch_text_init(&rendered, scratch);
+    handler->execute(ctrl, query, &rendered);
+    
+    int status = 0;
+    if (rendered.failed) {
+        fprintf(stderr, "Out of memory for query: %d\n", query->number);
+        status = -1;
+    } else {
+        if (rendered.length > 0) fwrite(rendered.data, 1, rendered.length, output);
+        pthread_mutex_lock(&ctrl->cache_lock);
+        query_cache_put(ctrl->cache, key, version, rendered.data, rendered.length);
+        pthread_mutex_unlock(&ctrl->cache_lock);
+    }
+    release_scratch(ctrl, scratch);
     
-    return 0;
+    return status;
+}
+
+QueryCacheStats controller_cache_stats(Controller* ctrl) {
+    if (!ctrl) return query_cache_stats(NULL);
+    pthread_mutex_lock(&ctrl->cache_lock);
+    QueryCacheStats stats = query_cache_stats(ctrl->cache);
+    pthread_mutex_unlock(&ctrl->cache_lock);
+    return stats;
+}
+
+unsigned controller_query_tables(const CompiledQuery* query) {
+    if (!query || query->empty) return 0;
+    
+    const QueryHandler* handler = find_handler(query->number);
+    return handler ? handler->tables : 0;
 }
 
 // Q1: Airport summary by code
-static void execute_query1(Controller* ctrl, const char* code, FILE* output) {
-    if (!code) {
-        fprintf(output, "\n");
+static void execute_query1(Controller* ctrl, const CompiledQuery* query, ScratchText* output) {
+    if (!query->args.q1.code) {
+        scratch_text_printf(output, "\n");
         return;
     }
     
+    char code[256];
+    snprintf(code, sizeof(code), "%.*s", (int)query->args.q1.length, query->args.q1.code);
     Airport* airport = database_get_airport(ctrl->db, code);
     if (!airport) {
-        fprintf(output, "\n");
+        scratch_text_printf(output, "\n");
         return;
     }
     
-    fprintf(output, "%s,%s,%s,%s,%s\n",
+    scratch_text_printf(output, "%s,%s,%s,%s,%s\n",
             airport_get_code(airport),
             airport_get_name(airport),
             airport_get_city(airport),
@@ -83,198 +312,149 @@ static void execute_query1(Controller* ctrl, const char* code, FILE* output) {
             airport_get_type(airport));
 }
 
-// Comparison function for sorting aircrafts by flight count (descending), then by ID
-static int compare_aircrafts(const void* a, const void* b) {
-    Aircraft* aircraft_a = *(Aircraft**)a;
-    Aircraft* aircraft_b = *(Aircraft**)b;
-    
-    int count_a = aircraft_get_flight_count(aircraft_a);
-    int count_b = aircraft_get_flight_count(aircraft_b);
-    
-    if (count_b != count_a) {
-        return count_b - count_a; // Descending by count
-    }
-    
-    // If counts are equal, sort by ID ascending
-    return strcmp(aircraft_get_id(aircraft_a), aircraft_get_id(aircraft_b));
-}
-
 // Q2: Top N aircrafts by flight count, optionally filtered by manufacturer
-static void execute_query2(Controller* ctrl, const char* arg, FILE* output) {
-    if (!arg) return;
-    
-    int n;
-    char manufacturer[128] = {0};
-    
-    // Parse arguments
-    if (strchr(arg, ' ')) {
-        sscanf(arg, "%d %127s", &n, manufacturer);
-    } else {
-        n = atoi(arg);
-    }
+static void execute_query2(Controller* ctrl, const CompiledQuery* query, ScratchText* output) {
+    int n = query->args.q2.n;
+    const char* manufacturer = query->args.q2.manufacturer;
     
      if (n <= 0) return;
      /* Use an unsigned size_t for comparisons with filtered_count to avoid
          signed/unsigned warnings and incorrect behavior when mixing types. */
      size_t requested = (size_t)n;
     
-    // Get all aircrafts
-    size_t count;
-    Aircraft** all_aircrafts = database_get_all_aircrafts(ctrl->db, &count);
-    if (!all_aircrafts || count == 0) {
-        // No aircrafts in database
-        fprintf(output, "\n");
-        return;
-    }
-    
-    // Filter by manufacturer if specified
-    Aircraft** filtered = NULL;
-    size_t filtered_count = 0;
-    
-    if (strlen(manufacturer) > 0) {
-        filtered = malloc(count * sizeof(Aircraft*));
-        for (size_t i = 0; i < count; i++) {
-            if (strcmp(aircraft_get_manufacturer(all_aircrafts[i]), manufacturer) == 0) {
-                filtered[filtered_count++] = all_aircrafts[i];
-            }
-        }
-    } else {
-        filtered = all_aircrafts;
-        filtered_count = count;
-    }
+    // Ranked by flight count (descending), then by ID (ascending), once
+    // per snapshot of the data: a query only reads the first N entries
+    AircraftRanking* ranking = index_manager_get(ctrl->indexes, ctrl->ranking_index);
+    if (!ranking) return;
     
+    size_t filtered_count;
+    Aircraft* const* filtered = aircraft_ranking_get(ranking, strlen(manufacturer) > 0 ? manufacturer : NULL,
+                                                     &filtered_count);
     if (filtered_count == 0) {
-        if (strlen(manufacturer) > 0) free(filtered);
         // No aircrafts match the filter / none available
-        fprintf(output, "\n");
+        scratch_text_printf(output, "\n");
+        index_manager_release(ctrl->indexes, ctrl->ranking_index);
         return;
     }
     
-    // Sort by flight count (descending), then by ID (ascending)
-    qsort(filtered, filtered_count, sizeof(Aircraft*), compare_aircrafts);
-    
     // Output top N
     size_t output_count = requested < filtered_count ? requested : filtered_count;
     for (size_t i = 0; i < output_count; i++) {
-        fprintf(output, "%s,%s,%s,%d\n",
+        scratch_text_printf(output, "%s,%s,%s,%d\n",
                 aircraft_get_id(filtered[i]),
                 aircraft_get_manufacturer(filtered[i]),
                 aircraft_get_model(filtered[i]),
                 aircraft_get_flight_count(filtered[i]));
     }
-    
-    if (strlen(manufacturer) > 0) free(filtered);
+    index_manager_release(ctrl->indexes, ctrl->ranking_index);
 }
 
-// Helper structure for Q3
-typedef struct {
-    Airport* airport;
-    size_t departure_count;
-} AirportDepartureCount;
+int controller_plan_query(Controller* ctrl, const CompiledQuery* query) {
+    if (!ctrl || !query) return -1;
+    if (query->empty || query->number != 3 || !query->args.q3.valid) return 0;   // only Q3 is batched
+    
+    Q3Range range = { .from = query->args.q3.from, .to = query->args.q3.to };
+    
+    if (ctrl->planned_count == ctrl->planned_capacity) {
+        size_t capacity = ctrl->planned_capacity ? ctrl->planned_capacity * 2 : 16;
+        Q3Range* grown = realloc(ctrl->planned, capacity * sizeof(Q3Range));
+        if (!grown) return -1;
+        ctrl->planned = grown;
+        ctrl->planned_capacity = capacity;
+    }
+    ctrl->planned[ctrl->planned_count++] = range;
+    index_manager_invalidate(ctrl->indexes, ctrl->planned_index);
+    return 0;
+}
 
-// Comparison function for sorting airports by departure count (descending), then by code
-static int compare_airport_departures(const void* a, const void* b) {
-    AirportDepartureCount* adc_a = (AirportDepartureCount*)a;
-    AirportDepartureCount* adc_b = (AirportDepartureCount*)b;
-    
-    if (adc_b->departure_count != adc_a->departure_count) {
-        return adc_b->departure_count - adc_a->departure_count; // Descending
+// Runs a table load for the background index builds
+static void load_tables(void* context, unsigned tables) {
+    ingestor_load_tables(context, tables);
+}
+
+int controller_prebuild_indexes(Controller* ctrl, const QueryPlan* plan, Ingestor* ingestor) {
+    if (!ctrl || !plan || !ingestor) return -1;
+    
+    // Only the indexes some query of the plan reads: Q3 ranges are all
+    // planned, so the per-query departure index is not one of them
+    unsigned ids = 0;
+    for (size_t i = 0; i < query_plan_count(plan); i++) {
+        const CompiledQuery* query = query_plan_get(plan, i);
+        if (query->empty) continue;
+        if (query->number == 2 && query->args.q2.n > 0) ids |= 1u << ctrl->ranking_index;
+        if (query->number == 3 && query->args.q3.valid && ctrl->planned_count > 0) {
+            ids |= 1u << ctrl->planned_index;
+        }
     }
-    
-    // If counts are equal, sort by code ascending (lexicographically)
-    return strcmp(airport_get_code(adc_a->airport), airport_get_code(adc_b->airport));
+    if (ids == 0) return 0;
+    return index_manager_build_in_background(ctrl->indexes, ids, load_tables, ingestor) ? 0 : -1;
 }
 
-// Q3: Airport with most departures between two dates
-static void execute_query3(Controller* ctrl, const char* arg, FILE* output) {
-    if (!arg) return;
-    
-    char date1_str[11], date2_str[11];
-    if (sscanf(arg, "%10s %10s", date1_str, date2_str) != 2) return;
-    
-    char date1_dt[17]; // "YYYY-MM-DD hh:mm"
-    char date2_dt[17];
-    snprintf(date1_dt, sizeof(date1_dt), "%s 00:00", date1_str);
-    snprintf(date2_dt, sizeof(date2_dt), "%s 00:00", date2_str);
+int controller_index_count(const Controller* ctrl) {
+    return ctrl ? index_manager_count(ctrl->indexes) : 0;
+}
 
-    if (!validate_datetime(date1_dt) || !validate_datetime(date2_dt)) return;
+IndexStats controller_index_stats(Controller* ctrl, int id) {
+    return index_manager_stats(ctrl ? ctrl->indexes : NULL, id);
+}
 
-    time_t date1 = parse_date(date1_str);
-    time_t date2 = parse_date(date2_str);
-    
-    // Ensure date1 <= date2
-    if (date1 > date2) {
-        time_t temp = date1;
-        date1 = date2;
-        date2 = temp;
-    }
-    
-    // Make date2 end of day (23:59:59)
-    date2 += 86399; // Add 23:59:59
+// Result of a planned Q3 range, from every planned range evaluated in one
+// sweep (again if flights were added since). False if the range was not
+// planned or the sweep ran out of memory.
+static bool planned_answer(Controller* ctrl, time_t from, time_t to, Q3Range* answer) {
+    if (ctrl->planned_count == 0) return false;
+    
+    const PlannedRanges* planned = index_manager_get(ctrl->indexes, ctrl->planned_index);
+    if (!planned) return false;
+    
+    Q3Range key = { .from = from, .to = to };
+    const Q3Range* found = bsearch(&key, planned->ranges, planned->count, sizeof(Q3Range), compare_ranges);
+    if (found) *answer = *found;
+    index_manager_release(ctrl->indexes, ctrl->planned_index);
+    return found != NULL;
+}
+
+// Q3: Airport with most departures between two dates
+static void execute_query3(Controller* ctrl, const CompiledQuery* query, ScratchText* output) {
+    if (!query->args.q3.valid) return;
     
-    // Count departures per airport
-    size_t airport_count;
-    Airport** airports = database_get_all_airports(ctrl->db, &airport_count);
+    time_t date1 = query->args.q3.from;
+    time_t date2 = query->args.q3.to;
     
-    AirportDepartureCount* counts = calloc(airport_count, sizeof(AirportDepartureCount));
-    for (size_t i = 0; i < airport_count; i++) {
-        counts[i].airport = airports[i];
-        counts[i].departure_count = 0;
+    // Busiest airport, ties broken by the smallest code: from the batch of
+    // planned ranges, else one subtraction per airport from the per-day
+    // aggregate, else two binary searches per airport over its sorted
+    // departure times. The aggregate rebuilds its prefix sums on the first
+    // query after flights were added, so it is read under the lock.
+    Airport* airport;
+    size_t departures;
+    Q3Range planned;
+    bool answered = true;
+    if (planned_answer(ctrl, date1, date2, &planned)) {
+        airport = planned.airport;
+        departures = planned.departures;
+    } else {
+        pthread_mutex_lock(&ctrl->lock);
+        answered = departure_days_busiest(database_get_departure_days(ctrl->db), date1, date2 - 86399,
+                                          &airport, &departures);
+        pthread_mutex_unlock(&ctrl->lock);
     }
-    
-    // Count flights for each airport in the date range
-    size_t flight_count;
-    Flight** flights = database_get_all_flights(ctrl->db, &flight_count);
-    
-    for (size_t i = 0; i < flight_count; i++) {
-        Flight* flight = flights[i];
-        const char* status = flight_get_status(flight);
-        
-        // Skip cancelled flights
-        if (status && strcmp(status, "Cancelled") == 0) continue;
-        
-        // Get actual departure time, or scheduled if not available
-        time_t departure = flight_get_actual_departure(flight);
-        if (departure == 0) {
-            departure = flight_get_departure(flight);
-        }
-        
-        // Check if in range
-        if (departure >= date1 && departure <= date2) {
-            const char* origin = flight_get_origin(flight);
-            
-            // Find the airport and increment count
-            for (size_t j = 0; j < airport_count; j++) {
-                if (strcmp(airport_get_code(counts[j].airport), origin) == 0) {
-                    counts[j].departure_count++;
-                    break;
-                }
-            }
-        }
+    if (!answered) {
+        DepartureIndex* index = index_manager_get(ctrl->indexes, ctrl->departures_index);
+        if (!index) return;
+        airport = departure_index_busiest(index, date1, date2, &departures);
+        index_manager_release(ctrl->indexes, ctrl->departures_index);
     }
     
-    // Sort by departure count (descending), then by code (ascending)
-    qsort(counts, airport_count, sizeof(AirportDepartureCount), compare_airport_departures);
-    
-    // If there are no airports in the database
-    if (airport_count == 0) {
-        fprintf(output, "\n");
-        free(counts);
-        return;
-    }
-
-    // Output the top airport (if it has departures)
-    if (counts[0].departure_count > 0) {
-        fprintf(output, "%s,%s,%s,%s,%lu\n",
-                airport_get_code(counts[0].airport),
-                airport_get_name(counts[0].airport),
-                airport_get_city(counts[0].airport),
-                airport_get_country(counts[0].airport),
-                (unsigned long)counts[0].departure_count);
+    if (airport && departures > 0) {
+        scratch_text_printf(output, "%s,%s,%s,%s,%lu\n",
+                airport_get_code(airport),
+                airport_get_name(airport),
+                airport_get_city(airport),
+                airport_get_country(airport),
+                (unsigned long)departures);
     } else {
-        // No airport has departures in the given timeframe
-        fprintf(output, "\n");
+        // No airports, or none with departures in the given timeframe
+        scratch_text_printf(output, "\n");
     }
-
-    free(counts);
 }
@@ -1,14 +1,16 @@
 #include "../include/database.h"
+#include "../include/departure_days.h"
 #include <stdlib.h>
 #include <string.h>
 
 #define DEFAULT_HASHTABLE_SIZE 1009 
 #define FLIGHTS_HASHTABLE_SIZE 10007
+#define MAX_LOAD_FACTOR 2              // average chain length that triggers a rehash
 
 // Hash table node for chaining
 typedef struct hash_node {
     void* data;                    // Pointer to the actual entity (Airport*, Flight*, etc.)
-    char* key;                     // String key (ID, code, document number, etc.)
+    const char* key;               // String key (ID, code, document number, etc.), owned by the entity
     struct hash_node* next;        // Next node in the chain
 } HashNode;
 
@@ -26,6 +28,8 @@ typedef struct database {
     HashTable* flights;            // Hash table for flights (key: flight id)
     HashTable* passengers;         // Hash table for passengers (key: document number)
     HashTable* reservations;       // Hash table for reservations (key: reservation id)
+    DepartureDays* departure_days; // Q3 aggregate, fed by the flights parser (NULL if keys only)
+    bool keys_only;                // Entities only carry the fields needed for reference checks
 } Database;
 
 // Hash function (djb2 algorithm)
@@ -56,7 +60,36 @@ static HashTable* hashtable_create(size_t initial_size) {
     return ht;
 }
 
-// Insert into hash table (returns 0 on success, -1 on error/duplicate)
+// Buckets for an expected number of keys: a load factor of 3/4, odd so the
+// modulo uses every bit of the hash. 0 keeps `fallback`.
+static size_t buckets_for(size_t expected, size_t fallback) {
+    return expected ? (expected + expected / 3) | 1 : fallback;
+}
+
+// Rehashes into `new_size` buckets. On allocation failure the table keeps
+// its current buckets (longer chains, still correct).
+static void hashtable_grow(HashTable* ht, size_t new_size) {
+    HashNode** buckets = calloc(new_size, sizeof(HashNode*));
+    if (!buckets) return;
+    
+    for (size_t i = 0; i < ht->size; i++) {
+        HashNode* current = ht->buckets[i];
+        while (current) {
+            HashNode* next = current->next;
+            unsigned int index = (unsigned int)(hash_string(current->key) % new_size);
+            current->next = buckets[index];
+            buckets[index] = current;
+            current = next;
+        }
+    }
+    
+    free(ht->buckets);
+    ht->buckets = buckets;
+    ht->size = new_size;
+}
+
+// Insert into hash table (returns 0 on success, -1 on error/duplicate).
+// The key is not copied: it must live as long as the data (it is the entity's own ID).
 static int hashtable_insert(HashTable* ht, const char* key, void* data) {
     if (!ht || !key || !data) return -1;
     
@@ -76,12 +109,16 @@ static int hashtable_insert(HashTable* ht, const char* key, void* data) {
     HashNode* new_node = malloc(sizeof(HashNode));
     if (!new_node) return -1;
     
-    new_node->key = strdup(key);
+    new_node->key = key;
     new_node->data = data;
     new_node->next = ht->buckets[index];
     ht->buckets[index] = new_node;
     ht->count++;
     
+    // Tables sized from a dataset profile rarely grow: only when the
+    // profile underestimated the rows (e.g. rows appended since)
+    if (ht->count > ht->size * MAX_LOAD_FACTOR) hashtable_grow(ht, ht->size * 2 + 1);
+    
     return 0;
 }
 
@@ -134,7 +171,6 @@ static void hashtable_destroy(HashTable* ht) {
         while (current) {
             HashNode* temp = current;
             current = current->next;
-            free(temp->key);
             free(temp);
         }
     }
@@ -144,32 +180,56 @@ static void hashtable_destroy(HashTable* ht) {
 }
 
 Database* database_create(void) {
+    return database_create_sized(NULL);
+}
+
+Database* database_create_sized(const DatabaseSizing* sizing) {
     Database* db = malloc(sizeof(Database));
     if (!db) return NULL;
     
+    DatabaseSizing none = { 0 };
+    if (!sizing) sizing = &none;
+    
     // Initialize hash tables
-    db->airports = hashtable_create(DEFAULT_HASHTABLE_SIZE);
-    db->aircrafts = hashtable_create(DEFAULT_HASHTABLE_SIZE);
-    db->flights = hashtable_create(FLIGHTS_HASHTABLE_SIZE);
-    db->passengers = hashtable_create(DEFAULT_HASHTABLE_SIZE);
-    db->reservations = hashtable_create(DEFAULT_HASHTABLE_SIZE);
+    db->airports = hashtable_create(buckets_for(sizing->airports, DEFAULT_HASHTABLE_SIZE));
+    db->aircrafts = hashtable_create(buckets_for(sizing->aircrafts, DEFAULT_HASHTABLE_SIZE));
+    db->flights = hashtable_create(buckets_for(sizing->flights, FLIGHTS_HASHTABLE_SIZE));
+    db->passengers = hashtable_create(buckets_for(sizing->passengers, DEFAULT_HASHTABLE_SIZE));
+    db->reservations = hashtable_create(buckets_for(sizing->reservations, DEFAULT_HASHTABLE_SIZE));
+    db->departure_days = departure_days_create();
     
     // Check if all hash tables were created successfully
     if (!db->airports || !db->aircrafts || !db->flights || 
-        !db->passengers || !db->reservations) {
+        !db->passengers || !db->reservations || !db->departure_days) {
         // Cleanup on failure
         if (db->airports) hashtable_destroy(db->airports);
         if (db->aircrafts) hashtable_destroy(db->aircrafts);
         if (db->flights) hashtable_destroy(db->flights);
         if (db->passengers) hashtable_destroy(db->passengers);
         if (db->reservations) hashtable_destroy(db->reservations);
+        departure_days_destroy(db->departure_days);
         free(db);
         return NULL;
     }
     
+    db->keys_only = false;
+    return db;
+}
+
+Database* database_create_keys_only(void) {
+    Database* db = database_create();
+    if (db) {
+        db->keys_only = true;
+        departure_days_destroy(db->departure_days);
+        db->departure_days = NULL;
+    }
     return db;
 }
 
+bool database_is_keys_only(const Database* db) {
+    return db && db->keys_only;
+}
+
 void database_destroy(Database* db) {
     if (!db) return;
     
@@ -233,6 +293,7 @@ void database_destroy(Database* db) {
         hashtable_destroy(db->reservations);
     }
     
+    departure_days_destroy(db->departure_days);
     free(db);
 }
 
@@ -306,6 +367,30 @@ Reservation* database_get_reservation(Database* db, const char* id) {
     return (Reservation*)hashtable_search(db->reservations, id);
 }
 
+DepartureDays* database_get_departure_days(Database* db) {
+    return db ? db->departure_days : NULL;
+}
+
+size_t database_count_airports(Database* db) {
+    return db && db->airports ? db->airports->count : 0;
+}
+
+size_t database_count_aircrafts(Database* db) {
+    return db && db->aircrafts ? db->aircrafts->count : 0;
+}
+
+size_t database_count_flights(Database* db) {
+    return db && db->flights ? db->flights->count : 0;
+}
+
+size_t database_count_passengers(Database* db) {
+    return db && db->passengers ? db->passengers->count : 0;
+}
+
+size_t database_count_reservations(Database* db) {
+    return db && db->reservations ? db->reservations->count : 0;
+}
+
 // Get all airports
 Airport** database_get_all_airports(Database* db, size_t* count) {
     if (!db || !count) return NULL;
@@ -0,0 +1,230 @@
+#include "../include/dataset_profile.h"
+#include "../include/line_reader.h"
+#include "../include/parser_utils.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LENGTH_HISTOGRAM 4096          // exact line-length counts below this, one bucket above
+
+// Columns profiled per table, by position in the CSV
+typedef struct {
+    const char* name;
+    int key;
+    int columns[PROFILE_MAX_COLUMNS];
+    const char* column_names[PROFILE_MAX_COLUMNS];
+    int column_count;
+    int dates[2];
+    const char* date_names[2];
+    int date_count;
+    int field_count;
+} TableLayout;
+
+static const TableLayout LAYOUTS[PROFILE_TABLE_COUNT] = {
+    { "airports", 0, { 3, 7 }, { "country", "type" }, 2, { 0 }, { NULL }, 0, 8 },
+    { "aircrafts", 0, { 1, 2, 3 }, { "manufacturer", "model", "year" }, 3, { 0 }, { NULL }, 0, 6 },
+    { "passengers", 0, { 4, 5 }, { "nationality", "gender" }, 2, { 3 }, { "dob" }, 1, 10 },
+    { "flights", 0, { 6, 7, 8, 9 }, { "status", "origin", "destination", "aircraft" }, 4,
+      { 1, 3 }, { "departure", "arrival" }, 2, 12 },
+    { "reservations", 0, { 5, 6 }, { "extra_luggage", "priority_boarding" }, 2, { 0 }, { NULL }, 0, 8 },
+};
+
+// Open-addressing set of 64-bit value hashes (0 marks a free slot)
+typedef struct {
+    uint64_t* slots;
+    size_t capacity;
+    size_t count;
+} DistinctSet;
+
+static uint64_t hash_value(const char* value) {
+    uint64_t hash = 1469598103934665603ULL;
+    while (*value) {
+        hash ^= (unsigned char)*value++;
+        hash *= 1099511628211ULL;
+    }
+    return hash ? hash : 1;
+}
+
+static bool set_insert_hash(DistinctSet* set, uint64_t hash) {
+    size_t i = (size_t)hash & (set->capacity - 1);
+    while (set->slots[i]) {
+        if (set->slots[i] == hash) return false;
+        i = (i + 1) & (set->capacity - 1);
+    }
+    set->slots[i] = hash;
+    set->count++;
+    return true;
+}
+
+static void set_insert(DistinctSet* set, const char* value) {
+    if ((set->count + 1) * 2 > set->capacity) {
+        DistinctSet grown = { calloc(set->capacity ? set->capacity * 2 : 1024, sizeof(uint64_t)),
+                              set->capacity ? set->capacity * 2 : 1024, 0 };
+        if (!grown.slots) return;   // the count stays a lower bound
+        for (size_t i = 0; i < set->capacity; i++) {
+            if (set->slots[i]) set_insert_hash(&grown, set->slots[i]);
+        }
+        free(set->slots);
+        *set = grown;
+    }
+    set_insert_hash(set, hash_value(value));
+}
+
+// Value of the first line length at or above `fraction` of the rows
+static size_t length_percentile(const size_t* histogram, size_t rows, size_t max, double fraction) {
+    size_t wanted = (size_t)(fraction * (double)rows);
+    size_t seen = 0;
+    for (size_t length = 0; length < LENGTH_HISTOGRAM; length++) {
+        seen += histogram[length];
+        if (seen > wanted) return length;
+    }
+    return max;
+}
+
+static void update_range(DateRangeProfile* range, const char* value) {
+    bool valid = strlen(value) == 16 ? validate_datetime(value) : validate_date(value);
+    if (!valid) return;
+    
+    if (!range->first || strcmp(value, range->first) < 0) {
+        strcpy(range->first_buffer, value);
+        range->first = range->first_buffer;
+    }
+    if (!range->last || strcmp(value, range->last) > 0) {
+        strcpy(range->last_buffer, value);
+        range->last = range->last_buffer;
+    }
+}
+
+static void scan_table(const char* dataset_path, const TableLayout* layout, TableProfile* table) {
+    memset(table, 0, sizeof(*table));
+    table->name = layout->name;
+    table->column_count = layout->column_count;
+    table->date_count = layout->date_count;
+    for (int c = 0; c < layout->column_count; c++) table->columns[c].name = layout->column_names[c];
+    for (int d = 0; d < layout->date_count; d++) table->dates[d].name = layout->date_names[d];
+    
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s.csv", dataset_path, layout->name);
+    LineReader* reader = line_reader_open(path);
+    if (!reader) return;
+    table->found = true;
+    
+    DistinctSet keys = { 0 };
+    DistinctSet columns[PROFILE_MAX_COLUMNS] = { { 0 } };
+    size_t* histogram = calloc(LENGTH_HISTOGRAM, sizeof(size_t));
+    size_t split_capacity = 4096;
+    char* split = malloc(split_capacity);
+    char* fields[16];
+    
+    char* line;
+    size_t length;
+    bool had_newline;
+    bool header = true;
+    table->line_min = SIZE_MAX;
+    
+    while (histogram && split && line_reader_next(reader, &line, &length, &had_newline)) {
+        if (header) {
+            header = false;
+            continue;
+        }
+        table->rows++;
+        if (length < table->line_min) table->line_min = length;
+        if (length > table->line_max) table->line_max = length;
+        if (length < LENGTH_HISTOGRAM) histogram[length]++;
+        
+        if (length + 1 > split_capacity) {
+            while (length + 1 > split_capacity) split_capacity *= 2;
+            char* grown = realloc(split, split_capacity);
+            if (!grown) break;
+            split = grown;
+        }
+        memcpy(split, line, length + 1);
+        if (parse_csv_line(split, fields, layout->field_count) < layout->field_count) continue;
+        
+        set_insert(&keys, fields[layout->key]);
+        for (int c = 0; c < layout->column_count; c++) set_insert(&columns[c], fields[layout->columns[c]]);
+        for (int d = 0; d < layout->date_count; d++) update_range(&table->dates[d], fields[layout->dates[d]]);
+    }
+    
+    if (table->rows == 0) table->line_min = 0;
+    if (histogram) {
+        table->line_p50 = length_percentile(histogram, table->rows, table->line_max, 0.50);
+        table->line_p99 = length_percentile(histogram, table->rows, table->line_max, 0.99);
+    }
+    table->keys = keys.count;
+    for (int c = 0; c < layout->column_count; c++) {
+        table->columns[c].distinct = columns[c].count;
+        free(columns[c].slots);
+    }
+    
+    free(keys.slots);
+    free(histogram);
+    free(split);
+    line_reader_close(reader);
+}
+
+bool dataset_profile_scan(const char* dataset_path, DatasetProfile* profile) {
+    if (!dataset_path || !profile) return false;
+    
+    bool any = false;
+    for (int t = 0; t < PROFILE_TABLE_COUNT; t++) {
+        scan_table(dataset_path, &LAYOUTS[t], &profile->tables[t]);
+        any = any || profile->tables[t].found;
+    }
+    return any;
+}
+
+bool dataset_profile_save(const DatasetProfile* profile, const char* path) {
+    FILE* fp = fopen(path, "w");
+    if (!fp) return false;
+    
+    for (int t = 0; t < PROFILE_TABLE_COUNT; t++) {
+        const TableProfile* table = &profile->tables[t];
+        if (!table->found) continue;
+        
+        fprintf(fp, "%s.rows %zu\n", table->name, table->rows);
+        fprintf(fp, "%s.keys %zu\n", table->name, table->keys);
+        for (int c = 0; c < table->column_count; c++) {
+            fprintf(fp, "%s.distinct.%s %zu\n", table->name, table->columns[c].name, table->columns[c].distinct);
+        }
+        for (int d = 0; d < table->date_count; d++) {
+            const DateRangeProfile* range = &table->dates[d];
+            if (!range->first) continue;
+            fprintf(fp, "%s.range.%s %s,%s\n", table->name, range->name, range->first, range->last);
+        }
+        fprintf(fp, "%s.line_length %zu,%zu,%zu,%zu\n", table->name,
+                table->line_min, table->line_p50, table->line_p99, table->line_max);
+    }
+    
+    bool ok = !ferror(fp);
+    return fclose(fp) == 0 && ok;
+}
+
+bool dataset_profile_load_sizing(const char* path, DatabaseSizing* sizing) {
+    if (!path || !sizing) return false;
+    FILE* fp = fopen(path, "r");
+    if (!fp) return false;
+    
+    memset(sizing, 0, sizeof(*sizing));
+    size_t* targets[PROFILE_TABLE_COUNT] = {
+        &sizing->airports, &sizing->aircrafts, &sizing->passengers, &sizing->flights, &sizing->reservations
+    };
+    
+    // Only "<table>.keys N" lines matter here; anything else is skipped
+    char line[256];
+    bool any = false;
+    while (fgets(line, sizeof(line), fp)) {
+        char name[64];
+        unsigned long long keys;
+        if (sscanf(line, "%63[a-z].keys %llu", name, &keys) != 2) continue;
+        for (int t = 0; t < PROFILE_TABLE_COUNT; t++) {
+            if (strcmp(name, LAYOUTS[t].name) == 0) {
+                *targets[t] = (size_t)keys;
+                any = true;
+            }
+        }
+    }
+    
+    fclose(fp);
+    return any;
+}
@@ -0,0 +1,242 @@
+#include "../include/departure_days.h"
+#include "../include/parser_utils.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SECONDS_PER_DAY 86400
+#define MAX_SPAN_DAYS 4096         // ~11 years: at most 32 KiB of counts and prefix sums per airport
+
+typedef struct {
+    Airport* airport;
+    uint32_t* counts;          // departures per day of the grid
+    uint32_t* prefix;          // prefix[d] = departures before day d (day_count + 1 entries)
+} DayColumn;
+
+typedef struct departure_days {
+    time_t origin;             // day 0 of the grid
+    long first_day;            // grid day of counts[0]
+    size_t day_count;
+    
+    DayColumn* columns;        // one per airport with departures
+    size_t column_count;
+    size_t column_capacity;
+    size_t* slots;             // open addressing: Airport* -> column + 1 (0: free)
+    size_t slot_capacity;
+    
+    // Departures too far from the grid to widen it (e.g. one outlier date),
+    // kept out of it: ranges reaching them are left to the caller
+    bool has_before;
+    long before_last;          // latest such day before the grid
+    bool has_after;
+    long after_first;          // earliest such day after the grid
+    
+    bool prefix_stale;         // counts changed since the prefix sums were built
+    bool broken;               // out of memory: answers nothing from then on
+} DepartureDays;
+
+DepartureDays* departure_days_create(void) {
+    DepartureDays* days = calloc(1, sizeof(DepartureDays));
+    // Dates and datetimes are both parsed as standard time, so days are
+    // always 86400 s long from a midnight parsed the same way
+    if (days) days->origin = parse_date("2000-01-01");
+    return days;
+}
+
+void departure_days_destroy(DepartureDays* days) {
+    if (!days) return;
+    for (size_t c = 0; c < days->column_count; c++) {
+        free(days->columns[c].counts);
+        free(days->columns[c].prefix);
+    }
+    free(days->columns);
+    free(days->slots);
+    free(days);
+}
+
+// Grid day of `when` (floor division, also before the origin)
+static long grid_day(const DepartureDays* days, time_t when) {
+    time_t offset = when - days->origin;
+    long day = (long)(offset / SECONDS_PER_DAY);
+    if (offset % SECONDS_PER_DAY < 0) day--;
+    return day;
+}
+
+static size_t slot_of(const DepartureDays* days, const Airport* airport) {
+    uintptr_t key = (uintptr_t)airport;
+    return (size_t)((key >> 4) * 0x9E3779B97F4A7C15ULL) & (days->slot_capacity - 1);
+}
+
+static bool grow_slots(DepartureDays* days) {
+    size_t capacity = days->slot_capacity ? days->slot_capacity * 2 : 256;
+    size_t* slots = calloc(capacity, sizeof(size_t));
+    if (!slots) return false;
+    
+    free(days->slots);
+    days->slots = slots;
+    days->slot_capacity = capacity;
+    for (size_t c = 0; c < days->column_count; c++) {
+        size_t i = slot_of(days, days->columns[c].airport);
+        while (slots[i]) i = (i + 1) & (capacity - 1);
+        slots[i] = c + 1;
+    }
+    return true;
+}
+
+// Column of `airport`, created on its first departure (NULL: out of memory)
+static DayColumn* column_of(DepartureDays* days, Airport* airport) {
+    if (days->slot_capacity) {
+        size_t i = slot_of(days, airport);
+        while (days->slots[i]) {
+            DayColumn* column = &days->columns[days->slots[i] - 1];
+            if (column->airport == airport) return column;
+            i = (i + 1) & (days->slot_capacity - 1);
+        }
+    }
+    
+    if ((days->column_count + 1) * 2 > days->slot_capacity && !grow_slots(days)) return NULL;
+    if (days->column_count == days->column_capacity) {
+        size_t capacity = days->column_capacity ? days->column_capacity * 2 : 64;
+        DayColumn* columns = realloc(days->columns, capacity * sizeof(DayColumn));
+        if (!columns) return NULL;
+        days->columns = columns;
+        days->column_capacity = capacity;
+    }
+    
+    DayColumn* column = &days->columns[days->column_count];
+    column->airport = airport;
+    column->counts = calloc(days->day_count ? days->day_count : 1, sizeof(uint32_t));
+    column->prefix = NULL;
+    if (!column->counts) return NULL;
+    
+    size_t i = slot_of(days, airport);
+    while (days->slots[i]) i = (i + 1) & (days->slot_capacity - 1);
+    days->slots[i] = ++days->column_count;
+    return column;
+}
+
+// Whether the grid can include `day` without spanning more than MAX_SPAN_DAYS
+static bool within_span(const DepartureDays* days, long day) {
+    if (!days->day_count) return true;
+    long first = day < days->first_day ? day : days->first_day;
+    long last = days->first_day + (long)days->day_count - 1;
+    if (day > last) last = day;
+    return last - first < MAX_SPAN_DAYS;
+}
+
+// Widens the grid to include `day` (within_span must hold), at least
+// doubling it up to MAX_SPAN_DAYS so that flights arriving in any order
+// cause few re-layouts
+static bool cover_day(DepartureDays* days, long day) {
+    long last = days->first_day + (long)days->day_count - 1;
+    if (days->day_count && day >= days->first_day && day <= last) return true;
+    
+    long new_first = days->first_day, new_last = last;
+    if (!days->day_count) {
+        new_first = new_last = day;
+    } else if (day < days->first_day) {
+        new_first = day < days->first_day - (long)days->day_count ? day : days->first_day - (long)days->day_count;
+        if (new_first < last - MAX_SPAN_DAYS + 1) new_first = last - MAX_SPAN_DAYS + 1;
+    } else {
+        new_last = day > last + (long)days->day_count ? day : last + (long)days->day_count;
+        if (new_last > days->first_day + MAX_SPAN_DAYS - 1) new_last = days->first_day + MAX_SPAN_DAYS - 1;
+    }
+    size_t new_count = (size_t)(new_last - new_first + 1);
+    size_t shift = (size_t)(days->first_day - new_first);
+    
+    for (size_t c = 0; c < days->column_count; c++) {
+        DayColumn* column = &days->columns[c];
+        uint32_t* counts = calloc(new_count, sizeof(uint32_t));
+        if (!counts) return false;
+        if (days->day_count) memcpy(counts + shift, column->counts, days->day_count * sizeof(uint32_t));
+        free(column->counts);
+        free(column->prefix);
+        column->counts = counts;
+        column->prefix = NULL;
+    }
+    days->first_day = new_first;
+    days->day_count = new_count;
+    return true;
+}
+
+void departure_days_add(DepartureDays* days, Airport* airport, time_t when) {
+    if (!days || !airport || days->broken) return;
+    
+    long day = grid_day(days, when);
+    if (!within_span(days, day)) {
+        if (day < days->first_day) {
+            if (!days->has_before || day > days->before_last) days->before_last = day;
+            days->has_before = true;
+        } else {
+            if (!days->has_after || day < days->after_first) days->after_first = day;
+            days->has_after = true;
+        }
+        return;
+    }
+    
+    DayColumn* column = NULL;
+    if (!cover_day(days, day) || !(column = column_of(days, airport))) {
+        days->broken = true;
+        return;
+    }
+    column->counts[day - days->first_day]++;
+    days->prefix_stale = true;
+}
+
+static bool build_prefix_sums(DepartureDays* days) {
+    for (size_t c = 0; c < days->column_count; c++) {
+        DayColumn* column = &days->columns[c];
+        if (!column->prefix) {
+            column->prefix = malloc((days->day_count + 1) * sizeof(uint32_t));
+            if (!column->prefix) return false;
+        }
+        column->prefix[0] = 0;
+        for (size_t d = 0; d < days->day_count; d++) {
+            column->prefix[d + 1] = column->prefix[d] + column->counts[d];
+        }
+    }
+    days->prefix_stale = false;
+    return true;
+}
+
+bool departure_days_busiest(DepartureDays* days, time_t first_day, time_t last_day,
+                            Airport** airport, size_t* departures) {
+    *airport = NULL;
+    *departures = 0;
+    if (!days || days->broken) return false;
+    
+    // The range must be made of whole grid days
+    if ((first_day - days->origin) % SECONDS_PER_DAY != 0 ||
+        (last_day - days->origin) % SECONDS_PER_DAY != 0) {
+        return false;
+    }
+    // Departures kept off the grid may fall in the range
+    if ((days->has_before && grid_day(days, first_day) <= days->before_last) ||
+        (days->has_after && grid_day(days, last_day) >= days->after_first)) {
+        return false;
+    }
+    if (days->day_count == 0) return true;    // no departures at all
+    if (days->prefix_stale && !build_prefix_sums(days)) {
+        days->broken = true;
+        return false;
+    }
+    
+    // Clamp to the grid: days outside it have no departures
+    long lo = grid_day(days, first_day) - days->first_day;
+    long hi = grid_day(days, last_day) - days->first_day + 1;
+    if (lo < 0) lo = 0;
+    if (hi > (long)days->day_count) hi = (long)days->day_count;
+    if (lo >= hi) return true;
+    
+    for (size_t c = 0; c < days->column_count; c++) {
+        DayColumn* column = &days->columns[c];
+        size_t count = column->prefix[hi] - column->prefix[lo];
+        if (count == 0 || count < *departures) continue;
+        if (count > *departures ||
+            strcmp(airport_get_code(column->airport), airport_get_code(*airport)) < 0) {
+            *departures = count;
+            *airport = column->airport;
+        }
+    }
+    return true;
+}
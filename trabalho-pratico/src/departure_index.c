@@ -0,0 +1,151 @@
+#include "../include/departure_index.h"
+#include "../include/airports.h"
+#include "../include/flights.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct departure_index {
+    Airport** airports;        // sorted by code
+    size_t airport_count;
+    size_t* starts;            // airport i owns times[starts[i] .. starts[i + 1])
+    time_t* times;
+} DepartureIndex;
+
+static int compare_airport_codes(const void* a, const void* b) {
+    return strcmp(airport_get_code(*(Airport**)a), airport_get_code(*(Airport**)b));
+}
+
+static int compare_times(const void* a, const void* b) {
+    time_t ta = *(const time_t*)a;
+    time_t tb = *(const time_t*)b;
+    return (ta > tb) - (ta < tb);
+}
+
+Airport** departure_index_sorted_airports(Database* db, size_t* count) {
+    Airport** airports = database_get_all_airports(db, count);
+    if (airports) qsort(airports, *count, sizeof(Airport*), compare_airport_codes);
+    return airports;
+}
+
+size_t departure_index_find_airport(Airport* const* airports, size_t count, const char* code) {
+    size_t lo = 0, hi = count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        int cmp = strcmp(airport_get_code(airports[mid]), code);
+        if (cmp == 0) return mid;
+        if (cmp < 0) lo = mid + 1;
+        else hi = mid;
+    }
+    return count;
+}
+
+// Same selection as the original Q3 scan: cancelled flights are skipped
+// and a missing actual departure falls back to the scheduled one
+bool departure_index_effective_departure(Flight* flight, time_t* departure) {
+    const char* status = flight_get_status(flight);
+    if (status && strcmp(status, "Cancelled") == 0) return false;
+    
+    *departure = flight_get_actual_departure(flight);
+    if (*departure == 0) *departure = flight_get_departure(flight);
+    return true;
+}
+
+DepartureIndex* departure_index_build(Database* db) {
+    DepartureIndex* index = calloc(1, sizeof(DepartureIndex));
+    if (!index) return NULL;
+    
+    index->airports = departure_index_sorted_airports(db, &index->airport_count);
+    size_t flight_count;
+    Flight** flights = database_get_all_flights(db, &flight_count);
+    index->starts = calloc(index->airport_count + 1, sizeof(size_t));
+    if (!index->starts || (index->airport_count > 0 && !index->airports) || (flight_count > 0 && !flights)) {
+        free(flights);
+        departure_index_destroy(index);
+        return NULL;
+    }
+    
+    // Airport of every counted flight (airport_count: skipped)
+    size_t* owners = malloc((flight_count ? flight_count : 1) * sizeof(size_t));
+    time_t* departures = malloc((flight_count ? flight_count : 1) * sizeof(time_t));
+    if (!owners || !departures) {
+        free(owners);
+        free(departures);
+        free(flights);
+        departure_index_destroy(index);
+        return NULL;
+    }
+    
+    // Counting pass, then one contiguous slice of times per airport
+    size_t counted = 0;
+    for (size_t i = 0; i < flight_count; i++) {
+        owners[i] = index->airport_count;
+        if (!departure_index_effective_departure(flights[i], &departures[i])) continue;
+        owners[i] = departure_index_find_airport(index->airports, index->airport_count,
+                                                 flight_get_origin(flights[i]));
+        if (owners[i] < index->airport_count) {
+            index->starts[owners[i] + 1]++;
+            counted++;
+        }
+    }
+    for (size_t a = 0; a < index->airport_count; a++) index->starts[a + 1] += index->starts[a];
+    
+    index->times = malloc((counted ? counted : 1) * sizeof(time_t));
+    size_t* fill = malloc((index->airport_count ? index->airport_count : 1) * sizeof(size_t));
+    if (index->times && fill) {
+        memcpy(fill, index->starts, index->airport_count * sizeof(size_t));
+        for (size_t i = 0; i < flight_count; i++) {
+            if (owners[i] < index->airport_count) index->times[fill[owners[i]]++] = departures[i];
+        }
+        for (size_t a = 0; a < index->airport_count; a++) {
+            qsort(index->times + index->starts[a], index->starts[a + 1] - index->starts[a],
+                  sizeof(time_t), compare_times);
+        }
+    }
+    
+    bool ok = index->times && fill;
+    free(fill);
+    free(owners);
+    free(departures);
+    free(flights);
+    if (!ok) {
+        departure_index_destroy(index);
+        return NULL;
+    }
+    return index;
+}
+
+void departure_index_destroy(DepartureIndex* index) {
+    if (!index) return;
+    free(index->airports);
+    free(index->starts);
+    free(index->times);
+    free(index);
+}
+
+// First position in [lo, hi) whose time is after t (upper) or not before
+// t (lower)
+static size_t bound(const time_t* times, size_t lo, size_t hi, time_t t, bool upper) {
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (times[mid] < t || (upper && times[mid] == t)) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+Airport* departure_index_busiest(const DepartureIndex* index, time_t from, time_t to, size_t* departures) {
+    *departures = 0;
+    if (!index || index->airport_count == 0) return NULL;
+    
+    size_t best = 0;
+    for (size_t a = 0; a < index->airport_count; a++) {
+        size_t lo = index->starts[a], hi = index->starts[a + 1];
+        if (hi - lo <= *departures) continue;   // cannot beat the current best
+        size_t count = bound(index->times, lo, hi, to, true) - bound(index->times, lo, hi, from, false);
+        if (count > *departures) {
+            *departures = count;
+            best = a;
+        }
+    }
+    return index->airports[best];
+}
@@ -3,6 +3,7 @@
 #include "../include/metricas.h"
 #include "../include/database.h"
 #include "../include/controller.h"
+#include "../include/contador_alocacoes.h"
 #include "../include/parser_airports.h"
 #include "../include/parser_aircrafts.h"
 #include "../include/parser_flights.h"
@@ -239,6 +240,13 @@ ProgramMetrics* execute_all_tests_integrated(const TestConfig* config) {
     char command[256];
     int query_num = 1;
     
+    // Chamadas ao heap feitas pelas queries; a primeira de cada tipo pode
+    // construir índices, as restantes não deviam precisar de nenhuma
+    static char buffer_saida[BUFSIZ];   // o output não aloca o seu buffer
+    bool tipo_visto[10] = { false };
+    size_t alocacoes = 0;
+    size_t alocacoes_estaveis = 0;
+    
     while (fgets(command, sizeof(command), input_file)) {
         // Remover quebra de linha
         size_t len = strlen(command);
@@ -277,8 +285,15 @@ ProgramMetrics* execute_all_tests_integrated(const TestConfig* config) {
         }
         simple_timer_start(query_timer);
         
-        // Executar query
-        int query_success = controller_execute_query(ctrl, command, output);
+        // Executar query (compilada antes da medição, como no programa
+        // principal: o mktime das datas do Q3 chama a libc, que aloca)
+        CompiledQuery query;
+        query_compile(command, &query);
+        setvbuf(output, buffer_saida, _IOFBF, sizeof(buffer_saida));
+        size_t heap_antes = contador_alocacoes() + contador_libertacoes();
+        int query_success = controller_execute_compiled(ctrl, &query, output);
+        fflush(output);
+        size_t heap_query = contador_alocacoes() + contador_libertacoes() - heap_antes;
         
         double query_time = simple_timer_end(query_timer);
         free_simple_timer(query_timer);
@@ -303,6 +318,11 @@ ProgramMetrics* execute_all_tests_integrated(const TestConfig* config) {
         
         // Adicionar resultado às métricas
         add_execution_result(metrics, query_type, query_time, test_passed);
+        alocacoes += heap_query;
+        if (query_type >= 1 && query_type <= 10) {
+            if (tipo_visto[query_type - 1]) alocacoes_estaveis += heap_query;
+            tipo_visto[query_type - 1] = true;
+        }
         
         // Libertar memória
         if (compare_result) {
@@ -318,6 +338,14 @@ ProgramMetrics* execute_all_tests_integrated(const TestConfig* config) {
     set_program_metrics_total_time(metrics, total_time);
     free_simple_timer(total_timer);
     
+    QueryCacheStats cache = controller_cache_stats(ctrl);
+    set_program_metrics_cache(metrics, cache.lookups, cache.hits);
+    set_program_metrics_alocacoes(metrics, alocacoes, alocacoes_estaveis);
+    for (int i = 0; i < controller_index_count(ctrl); i++) {
+        IndexStats indice = controller_index_stats(ctrl, i);
+        add_index_metrics(metrics, indice.name, indice.builds, indice.build_seconds, indice.cost);
+    }
+    
     // Cleanup
     // controller_destroy(ctrl);
     // database_destroy(db);
@@ -0,0 +1,198 @@
+#include "../include/index_manager.h"
+#include "../include/ingestor.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <time.h>
+
+typedef struct {
+    IndexSpec spec;
+    void* index;
+    bool built;                    // index (possibly NULL) matches `rows`
+    bool building;                 // a thread is building it, outside the lock
+    bool invalidated;              // its inputs other than the tables changed since
+    int readers;                   // gets of `index` not released yet
+    size_t rows;                   // rows of its tables when it was built
+    int builds;
+    double seconds;
+    size_t cost;
+} IndexEntry;
+
+typedef struct index_manager {
+    Database* db;
+    IndexEntry entries[INDEX_MANAGER_MAX];
+    int count;
+    pthread_mutex_t mutex;         // guards every entry
+    pthread_cond_t built;
+    pthread_cond_t released;       // some entry lost its last reader
+    pthread_t builder;
+    bool has_builder;
+    unsigned background_ids;       // for the builder thread
+    void (*wait_tables)(void* context, unsigned tables);
+    void* wait_context;
+} IndexManager;
+
+IndexManager* index_manager_create(Database* db) {
+    IndexManager* manager = calloc(1, sizeof(IndexManager));
+    if (!manager) return NULL;
+    manager->db = db;
+    pthread_mutex_init(&manager->mutex, NULL);
+    pthread_cond_init(&manager->built, NULL);
+    pthread_cond_init(&manager->released, NULL);
+    return manager;
+}
+
+void index_manager_destroy(IndexManager* manager) {
+    if (!manager) return;
+    if (manager->has_builder) pthread_join(manager->builder, NULL);
+    for (int i = 0; i < manager->count; i++) {
+        IndexEntry* entry = &manager->entries[i];
+        if (entry->index) entry->spec.destroy(entry->index);
+    }
+    pthread_mutex_destroy(&manager->mutex);
+    pthread_cond_destroy(&manager->built);
+    pthread_cond_destroy(&manager->released);
+    free(manager);
+}
+
+int index_manager_register(IndexManager* manager, const IndexSpec* spec) {
+    if (!manager || !spec || !spec->build || !spec->destroy) return -1;
+    
+    pthread_mutex_lock(&manager->mutex);
+    int id = -1;
+    if (manager->count < INDEX_MANAGER_MAX) {
+        id = manager->count++;
+        manager->entries[id] = (IndexEntry){ .spec = *spec };
+    }
+    pthread_mutex_unlock(&manager->mutex);
+    return id;
+}
+
+static double seconds_since(const struct timespec* start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+void* index_manager_get(IndexManager* manager, int id) {
+    if (!manager || id < 0 || id >= manager->count) return NULL;
+    IndexEntry* entry = &manager->entries[id];
+    
+    pthread_mutex_lock(&manager->mutex);
+    for (;;) {
+        size_t rows = ingestor_count_rows(manager->db, entry->spec.tables);
+        if (entry->built && !entry->invalidated && entry->rows == rows) break;
+        if (entry->building) {
+            pthread_cond_wait(&manager->built, &manager->mutex);
+            continue;
+        }
+    
+        // Built outside the lock, so other indexes can be read meanwhile;
+        // threads asking for this one wait above. The stale one is only
+        // destroyed once the threads still reading it released it: no new
+        // reader can take it while `building` is set.
+        entry->building = true;
+        entry->invalidated = false;
+        while (entry->readers > 0) pthread_cond_wait(&manager->released, &manager->mutex);
+        void* stale = entry->index;
+        entry->index = NULL;
+        entry->built = false;
+        pthread_mutex_unlock(&manager->mutex);
+    
+        if (stale) entry->spec.destroy(stale);
+        size_t cost = entry->spec.cost ? entry->spec.cost(manager->db, entry->spec.context) : 0;
+        struct timespec start;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        void* index = entry->spec.build(manager->db, entry->spec.context);
+        double seconds = seconds_since(&start);
+    
+        pthread_mutex_lock(&manager->mutex);
+        entry->index = index;
+        entry->built = true;
+        entry->building = false;
+        entry->rows = rows;
+        entry->builds++;
+        entry->seconds += seconds;
+        entry->cost = cost;
+        pthread_cond_broadcast(&manager->built);
+    }
+    void* index = entry->index;
+    if (index) entry->readers++;
+    pthread_mutex_unlock(&manager->mutex);
+    return index;
+}
+
+void index_manager_release(IndexManager* manager, int id) {
+    if (!manager || id < 0 || id >= manager->count) return;
+    pthread_mutex_lock(&manager->mutex);
+    IndexEntry* entry = &manager->entries[id];
+    if (entry->readers > 0 && --entry->readers == 0) pthread_cond_broadcast(&manager->released);
+    pthread_mutex_unlock(&manager->mutex);
+}
+
+void index_manager_invalidate(IndexManager* manager, int id) {
+    if (!manager || id < 0 || id >= manager->count) return;
+    pthread_mutex_lock(&manager->mutex);
+    manager->entries[id].invalidated = true;
+    pthread_mutex_unlock(&manager->mutex);
+}
+
+static void* build_in_background(void* arg) {
+    IndexManager* manager = arg;
+    unsigned ids = manager->background_ids;
+    
+    unsigned tables = 0;
+    for (int i = 0; i < manager->count; i++) {
+        if (ids & (1u << i)) tables |= manager->entries[i].spec.tables;
+    }
+    if (manager->wait_tables) manager->wait_tables(manager->wait_context, tables);
+    
+    // Most expensive first: it is the one a query would wait longest for
+    while (ids) {
+        int next = -1;
+        size_t next_cost = 0;
+        for (int i = 0; i < manager->count; i++) {
+            if (!(ids & (1u << i))) continue;
+            const IndexSpec* spec = &manager->entries[i].spec;
+            size_t cost = spec->cost ? spec->cost(manager->db, spec->context) : 0;
+            if (next < 0 || cost > next_cost) {
+                next = i;
+                next_cost = cost;
+            }
+        }
+        if (next < 0) break;
+        ids &= ~(1u << next);
+        if (index_manager_get(manager, next)) index_manager_release(manager, next);
+    }
+    return NULL;
+}
+
+bool index_manager_build_in_background(IndexManager* manager, unsigned ids,
+                                       void (*wait_tables)(void* context, unsigned tables),
+                                       void* context) {
+    if (!manager || manager->has_builder) return false;
+    
+    manager->background_ids = ids;
+    manager->wait_tables = wait_tables;
+    manager->wait_context = context;
+    if (pthread_create(&manager->builder, NULL, build_in_background, manager) != 0) return false;
+    manager->has_builder = true;
+    return true;
+}
+
+int index_manager_count(const IndexManager* manager) {
+    return manager ? manager->count : 0;
+}
+
+IndexStats index_manager_stats(IndexManager* manager, int id) {
+    IndexStats stats = { 0 };
+    if (!manager || id < 0 || id >= manager->count) return stats;
+    
+    pthread_mutex_lock(&manager->mutex);
+    const IndexEntry* entry = &manager->entries[id];
+    stats.name = entry->spec.name;
+    stats.builds = entry->builds;
+    stats.build_seconds = entry->seconds;
+    stats.cost = entry->cost;
+    pthread_mutex_unlock(&manager->mutex);
+    return stats;
+}
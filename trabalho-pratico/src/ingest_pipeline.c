@@ -0,0 +1,324 @@
+#include "../include/ingest_pipeline.h"
+#include "../include/parser_utils.h"
+#include "../include/parse_stats.h"
+#include "../include/spsc_ring.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define PIPELINE_MIN_BYTES (4L << 20)      // below this the threads cost more than they save
+#define PIPELINE_MAX_VALIDATORS 4
+#define BATCH_ROWS 1024
+#define BATCH_BYTES (256 * 1024)
+#define RING_CAPACITY 2                    // batches queued between two stages
+
+typedef struct {
+    size_t offset;                         // start of the line in the batch text
+    size_t length;
+    bool had_newline;
+    bool passed;                           // column checks passed (set by a validator)
+    char* fields[PARSER_MAX_FIELDS];
+    ParsedRow parsed;
+} PipelineRow;
+
+typedef struct {
+    char* text;                            // the lines, each NUL-terminated, for the error log
+    size_t text_used;
+    size_t text_capacity;
+    char* split;                           // validator's copy of text, split in place (padded)
+    size_t split_capacity;
+    bool split_failed;                     // no memory for the split copy: rows left unchecked
+    PipelineRow* rows;
+    int count;
+    size_t first_index;                    // row number of rows[0]
+    off_t consumed;                        // source offset after the last row
+} Batch;
+
+typedef struct {
+    const TableSchema* schema;
+    Database* db;
+    LineReader* reader;
+    bool complete_lines_only;
+    off_t start_offset;
+    int validator_count;
+    
+    SpscRing free_batches;                 // inserter -> reader
+    SpscRing to_validator[PIPELINE_MAX_VALIDATORS];
+    SpscRing to_inserter[PIPELINE_MAX_VALIDATORS];
+    Batch* batches;
+    int batch_count;
+    
+    bool read_failed;                      // written by the reader before its end marker
+    bool stop;                             // set by the inserter: read no further
+} Pipeline;
+
+typedef struct {
+    Pipeline* pipeline;
+    int index;
+} ValidatorArg;
+
+// Pushed once into every ring after the last batch
+static Batch END_OF_INPUT;
+
+int ingest_pipeline_validators(const char* filepath, off_t offset) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus < 2) return 0;
+    
+    // Decompressed bytes for a gzip source: that is what the stages handle
+    off_t size = line_reader_source_size(filepath);
+    if (size < 0 || size - offset < PIPELINE_MIN_BYTES) return 0;
+    
+    // One core each for the reader and the inserter, the rest validate
+    long validators = cpus - 2;
+    if (validators < 1) validators = 1;
+    if (validators > PIPELINE_MAX_VALIDATORS) validators = PIPELINE_MAX_VALIDATORS;
+    return (int)validators;
+}
+
+// Appends one line to the batch; false if the batch could not grow
+static bool batch_add(Batch* batch, const char* line, size_t length, bool had_newline) {
+    if (batch->text_used + length + 1 > batch->text_capacity) {
+        size_t new_capacity = batch->text_capacity ? batch->text_capacity : BATCH_BYTES;
+        while (batch->text_used + length + 1 > new_capacity) new_capacity *= 2;
+        char* grown = realloc(batch->text, new_capacity);
+        if (!grown) return false;
+        batch->text = grown;
+        batch->text_capacity = new_capacity;
+    }
+    
+    PipelineRow* row = &batch->rows[batch->count++];
+    row->offset = batch->text_used;
+    row->length = length;
+    row->had_newline = had_newline;
+    memcpy(batch->text + batch->text_used, line, length + 1);
+    batch->text_used += length + 1;
+    return true;
+}
+
+static bool batch_full(const Batch* batch) {
+    return batch->count == BATCH_ROWS || batch->text_used >= BATCH_BYTES;
+}
+
+static void* read_rows(void* arg) {
+    Pipeline* p = arg;
+    PARSE_STATS_BEGIN(p->schema);
+    
+    char* line;
+    size_t length;
+    bool had_newline;
+    size_t seq = 0;
+    size_t row_index = 0;
+    off_t consumed = p->start_offset;
+    Batch* batch = NULL;
+    
+    while (!__atomic_load_n(&p->stop, __ATOMIC_ACQUIRE) &&
+           line_reader_next(p->reader, &line, &length, &had_newline)) {
+        // A writer may still be appending to an unterminated last line
+        if (!had_newline && p->complete_lines_only) break;
+        
+        if (!batch) {
+            PARSE_STATS_LAP(STAGE_READ);
+            batch = spsc_ring_pop(&p->free_batches);
+            PARSE_STATS_LAP(STAGE_WAIT);
+            batch->first_index = row_index;
+        }
+        PARSE_STATS_ROW();
+        if (!batch_add(batch, line, length, had_newline)) {
+            p->read_failed = true;
+            break;
+        }
+        consumed = line_reader_line_offset(p->reader) + (off_t)(length + had_newline);
+        batch->consumed = consumed;
+        row_index++;
+        
+        if (batch_full(batch)) {
+            PARSE_STATS_LAP(STAGE_READ);
+            spsc_ring_push(&p->to_validator[seq++ % p->validator_count], batch);
+            PARSE_STATS_LAP(STAGE_WAIT);
+            batch = NULL;
+        }
+    }
+    PARSE_STATS_LAP(STAGE_READ);
+    
+    if (batch && batch->count > 0) {
+        spsc_ring_push(&p->to_validator[seq++ % p->validator_count], batch);
+    }
+    // An empty batch left over is simply never used again
+    
+    for (int k = 0; k < p->validator_count; k++) {
+        spsc_ring_push(&p->to_validator[k], &END_OF_INPUT);
+    }
+    PARSE_STATS_LAP(STAGE_WAIT);
+    PARSE_STATS_END();
+    return NULL;
+}
+
+static void* validate_rows(void* arg) {
+    ValidatorArg* va = arg;
+    Pipeline* p = va->pipeline;
+    const TableSchema* schema = p->schema;
+    PARSE_STATS_BEGIN(schema);
+    
+    for (;;) {
+        Batch* batch = spsc_ring_pop(&p->to_validator[va->index]);
+        PARSE_STATS_LAP(STAGE_WAIT);
+        if (batch == &END_OF_INPUT) break;
+        
+        // Splitting is destructive: one copy of the whole batch text
+        if (batch->text_used > batch->split_capacity) {
+            char* grown = realloc(batch->split, batch->text_capacity + FIELD_PADDING);
+            if (grown) {
+                batch->split = grown;
+                batch->split_capacity = batch->text_capacity;
+            }
+        }
+        // Without it the rows cannot be checked; the inserter stops there
+        // rather than logging them as rejected
+        batch->split_failed = batch->text_used > batch->split_capacity;
+        if (!batch->split_failed) memcpy(batch->split, batch->text, batch->text_used);
+        
+        for (int i = 0; i < batch->count && !batch->split_failed; i++) {
+            PipelineRow* row = &batch->rows[i];
+            row->parsed.fields = row->fields;
+            
+            int field_count = parse_csv_line(batch->split + row->offset, row->fields, schema->field_count);
+            PARSE_STATS_LAP(STAGE_SPLIT);
+            if (field_count < schema->field_count) {
+                PARSE_STATS_SHORT_ROW();
+                row->passed = false;
+                continue;
+            }
+            row->passed = parser_check_fields(schema, &row->parsed, p->db);
+            PARSE_STATS_LAP(STAGE_VALIDATE);
+        }
+        
+        spsc_ring_push(&p->to_inserter[va->index], batch);
+        PARSE_STATS_LAP(STAGE_WAIT);
+    }
+    
+    spsc_ring_push(&p->to_inserter[va->index], &END_OF_INPUT);
+    PARSE_STATS_END();
+    return NULL;
+}
+
+static void destroy_pipeline(Pipeline* p) {
+    for (int i = 0; i < p->batch_count; i++) {
+        free(p->batches[i].text);
+        free(p->batches[i].split);
+        free(p->batches[i].rows);
+    }
+    free(p->batches);
+    spsc_ring_destroy(&p->free_batches);
+    for (int k = 0; k < p->validator_count; k++) {
+        spsc_ring_destroy(&p->to_validator[k]);
+        spsc_ring_destroy(&p->to_inserter[k]);
+    }
+}
+
+static bool create_pipeline(Pipeline* p, int validators) {
+    p->validator_count = validators;
+    
+    // Enough batches for every ring slot plus one being worked on per stage
+    p->batch_count = validators * (2 * RING_CAPACITY + 1) + 2;
+    p->batches = calloc((size_t)p->batch_count, sizeof(Batch));
+    bool ok = p->batches && spsc_ring_init(&p->free_batches, (size_t)p->batch_count);
+    for (int k = 0; k < validators && ok; k++) {
+        ok = spsc_ring_init(&p->to_validator[k], RING_CAPACITY + 1) &&
+             spsc_ring_init(&p->to_inserter[k], RING_CAPACITY + 1);
+    }
+    for (int i = 0; i < p->batch_count && ok; i++) {
+        p->batches[i].rows = malloc(BATCH_ROWS * sizeof(PipelineRow));
+        ok = p->batches[i].rows != NULL;
+        if (ok) spsc_ring_try_push(&p->free_batches, &p->batches[i]);
+    }
+    return ok;
+}
+
+bool ingest_pipeline_run(LineReader* reader, const TableSchema* schema, Database* db,
+                         RejectLog* rejects, bool complete_lines_only, void* context,
+                         off_t consumed, int validators, PipelineResult* result) {
+    if (validators < 1) return false;
+    if (validators > PIPELINE_MAX_VALIDATORS) validators = PIPELINE_MAX_VALIDATORS;
+    
+    Pipeline p = {
+        .schema = schema, .db = db, .reader = reader,
+        .complete_lines_only = complete_lines_only, .start_offset = consumed,
+    };
+    if (!create_pipeline(&p, validators)) {
+        destroy_pipeline(&p);
+        return false;
+    }
+    
+    // Validators first: if one cannot start, the others are stopped before
+    // anything has been read
+    pthread_t validator_threads[PIPELINE_MAX_VALIDATORS];
+    ValidatorArg args[PIPELINE_MAX_VALIDATORS];
+    int started = 0;
+    for (; started < validators; started++) {
+        args[started] = (ValidatorArg){ &p, started };
+        if (pthread_create(&validator_threads[started], NULL, validate_rows, &args[started]) != 0) break;
+    }
+    pthread_t reader_thread;
+    if (started < validators || pthread_create(&reader_thread, NULL, read_rows, &p) != 0) {
+        for (int k = 0; k < started; k++) {
+            spsc_ring_push(&p.to_validator[k], &END_OF_INPUT);
+            pthread_join(validator_threads[k], NULL);
+        }
+        destroy_pipeline(&p);
+        return false;
+    }
+    
+    // Inserter: batches come back in file order by taking them round-robin
+    result->valid_count = 0;
+    result->error_count = 0;
+    result->consumed = consumed;
+    bool stopped = false;                  // a batch could not be checked; the rest are drained unused
+    for (size_t seq = 0; ; seq++) {
+        Batch* batch = spsc_ring_pop(&p.to_inserter[seq % (size_t)validators]);
+        PARSE_STATS_LAP(STAGE_WAIT);
+        if (batch == &END_OF_INPUT) break;
+        
+        if (batch->split_failed && !stopped) {
+            stopped = true;
+            __atomic_store_n(&p.stop, true, __ATOMIC_RELEASE);
+        }
+        if (stopped) {
+            batch->count = 0;
+            batch->text_used = 0;
+            spsc_ring_push(&p.free_batches, batch);
+            continue;
+        }
+        
+        for (int i = 0; i < batch->count; i++) {
+            PipelineRow* row = &batch->rows[i];
+            row->parsed.index = batch->first_index + (size_t)i;
+            row->parsed.context = context;
+            
+            bool stored = row->passed && schema->load_row(&row->parsed, db);
+            PARSE_STATS_LAP(STAGE_VALIDATE);   // whatever load_row did not charge elsewhere
+            if (stored) {
+                result->valid_count++;
+            } else {
+                // Offsets are relative to the batch text, which holds the rows verbatim
+                reject_log_record(rejects, (off_t)row->offset, row->length, row->had_newline);
+                if (reject_log_full(rejects)) reject_log_flush(rejects, batch->text, 0);
+                result->error_count++;
+            }
+        }
+        reject_log_flush(rejects, batch->text, 0);
+        PARSE_STATS_LAP(STAGE_LOG);
+        
+        result->consumed = batch->consumed;
+        batch->count = 0;
+        batch->text_used = 0;
+        spsc_ring_push(&p.free_batches, batch);
+    }
+    
+    pthread_join(reader_thread, NULL);
+    for (int k = 0; k < validators; k++) pthread_join(validator_threads[k], NULL);
+    result->failed = p.read_failed || stopped;
+    
+    destroy_pipeline(&p);
+    return true;
+}
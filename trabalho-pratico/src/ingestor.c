@@ -0,0 +1,229 @@
+#include "../include/ingestor.h"
+#include "../include/parser_airports.h"
+#include "../include/parser_aircrafts.h"
+#include "../include/parser_flights.h"
+#include "../include/parser_passengers.h"
+#include "../include/parser_reservations.h"
+#include "../include/line_reader.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define INGESTOR_TABLE_COUNT 5
+
+typedef struct {
+    const char* name;              // file name stem, e.g. "airports"
+    const TableSchema* schema;
+    char path[512];                // <dataset>/<name>.csv
+    FILE* error_log;               // <results>/<name>_errors.csv, kept open for appends
+    TableCheckpoint checkpoint;
+    unsigned requires;             // INGEST_* bits of the referenced tables
+    int status;                    // result of the initial load
+    struct ingestor* ingestor;     // back pointer for the loader thread
+    int index;
+    pthread_t loader;
+    bool has_loader;
+} IngestTable;
+
+typedef struct ingestor {
+    Database* db;
+    IngestTable tables[INGESTOR_TABLE_COUNT];   // in dependency order, table i is bit i
+    pthread_mutex_t mutex;                      // guards claimed and ready
+    pthread_cond_t became_ready;
+    unsigned claimed;                           // tables some thread is loading or has loaded
+    unsigned ready;                             // tables fully loaded
+} Ingestor;
+
+size_t ingestor_count_rows(Database* db, unsigned tables) {
+    size_t rows = 0;
+    if (tables & INGEST_AIRPORTS) rows += database_count_airports(db);
+    if (tables & INGEST_AIRCRAFTS) rows += database_count_aircrafts(db);
+    if (tables & INGEST_PASSENGERS) rows += database_count_passengers(db);
+    if (tables & INGEST_FLIGHTS) rows += database_count_flights(db);
+    if (tables & INGEST_RESERVATIONS) rows += database_count_reservations(db);
+    return rows;
+}
+
+Ingestor* ingestor_create(const char* dataset_path, const char* results_dir, Database* db, bool incremental) {
+    if (!dataset_path || !results_dir || !db) return NULL;
+    
+    Ingestor* ingestor = calloc(1, sizeof(Ingestor));
+    if (!ingestor) return NULL;
+    ingestor->db = db;
+    
+    // Dependency order: flights need airports and aircrafts, reservations
+    // need passengers and flights
+    const char* names[INGESTOR_TABLE_COUNT] = { "airports", "aircrafts", "passengers", "flights", "reservations" };
+    const TableSchema* schemas[INGESTOR_TABLE_COUNT] = {
+        &AIRPORTS_SCHEMA, &AIRCRAFTS_SCHEMA, &PASSENGERS_SCHEMA, &FLIGHTS_SCHEMA, &RESERVATIONS_SCHEMA
+    };
+    const unsigned requires[INGESTOR_TABLE_COUNT] = {
+        0, 0, 0, INGEST_AIRPORTS | INGEST_AIRCRAFTS, INGEST_PASSENGERS | INGEST_FLIGHTS
+    };
+    pthread_mutex_init(&ingestor->mutex, NULL);
+    pthread_cond_init(&ingestor->became_ready, NULL);
+    
+    for (int i = 0; i < INGESTOR_TABLE_COUNT; i++) {
+        IngestTable* table = &ingestor->tables[i];
+        table->name = names[i];
+        table->schema = schemas[i];
+        table->requires = requires[i];
+        table->ingestor = ingestor;
+        table->index = i;
+        table->checkpoint.complete_lines_only = incremental;
+        snprintf(table->path, sizeof(table->path), "%s/%s.csv", dataset_path, names[i]);
+        
+        // Appended rows are found by offset, which a gzip stream does not have
+        char source[1024];
+        bool compressed;
+        if (incremental && line_reader_source(table->path, source, sizeof(source), &compressed) && compressed) {
+            fprintf(stderr, "%s is compressed: appended rows can only be read from a plain CSV\n", source);
+            ingestor_destroy(ingestor);
+            return NULL;
+        }
+        
+        char error_path[512];
+        snprintf(error_path, sizeof(error_path), "%s/%s_errors.csv", results_dir, names[i]);
+        table->error_log = fopen(error_path, "w");
+        if (!table->error_log) {
+            ingestor_destroy(ingestor);
+            return NULL;
+        }
+    }
+    
+    return ingestor;
+}
+
+void ingestor_destroy(Ingestor* ingestor) {
+    if (!ingestor) return;
+    ingestor_wait(ingestor);
+    pthread_mutex_destroy(&ingestor->mutex);
+    pthread_cond_destroy(&ingestor->became_ready);
+    for (int i = 0; i < INGESTOR_TABLE_COUNT; i++) {
+        if (ingestor->tables[i].error_log) fclose(ingestor->tables[i].error_log);
+    }
+    free(ingestor);
+}
+
+int ingestor_load_all(Ingestor* ingestor) {
+    return ingestor_load_tables(ingestor, INGEST_ALL);
+}
+
+// Closes a set of tables over the tables they reference. Referenced tables
+// come first in the table order, so one backwards pass is enough.
+static unsigned with_dependencies(const Ingestor* ingestor, unsigned tables) {
+    for (int i = INGESTOR_TABLE_COUNT - 1; i >= 0; i--) {
+        if (tables & (1u << i)) tables |= ingestor->tables[i].requires;
+    }
+    return tables & INGEST_ALL;
+}
+
+// Loads table i (after its dependencies) unless another thread claimed it
+// first, in which case waits for that thread to finish it
+static int ensure_loaded(Ingestor* ingestor, int i) {
+    IngestTable* table = &ingestor->tables[i];
+    unsigned bit = 1u << i;
+    
+    for (int d = 0; d < i; d++) {
+        if (table->requires & (1u << d)) ensure_loaded(ingestor, d);
+    }
+    
+    pthread_mutex_lock(&ingestor->mutex);
+    if (ingestor->claimed & bit) {
+        while (!(ingestor->ready & bit)) pthread_cond_wait(&ingestor->became_ready, &ingestor->mutex);
+        pthread_mutex_unlock(&ingestor->mutex);
+        return table->status;
+    }
+    ingestor->claimed |= bit;
+    pthread_mutex_unlock(&ingestor->mutex);
+    
+    printf("Loading %s...\n", table->name);
+    table->status = parse_table_resume(table->path, table->schema, ingestor->db,
+                                       table->error_log, &table->checkpoint);
+    if (table->status != 0) {
+        fprintf(stderr, "Warning: Issues loading %s\n", table->name);
+    }
+    fflush(table->error_log);
+    
+    pthread_mutex_lock(&ingestor->mutex);
+    ingestor->ready |= bit;
+    pthread_cond_broadcast(&ingestor->became_ready);
+    pthread_mutex_unlock(&ingestor->mutex);
+    return table->status;
+}
+
+int ingestor_load_tables(Ingestor* ingestor, unsigned tables) {
+    if (!ingestor) return -1;
+    
+    tables = with_dependencies(ingestor, tables);
+    int status = 0;
+    for (int i = 0; i < INGESTOR_TABLE_COUNT; i++) {
+        if ((tables & (1u << i)) && ensure_loaded(ingestor, i) != 0) status = -1;
+    }
+    return status;
+}
+
+unsigned ingestor_loaded_tables(Ingestor* ingestor) {
+    if (!ingestor) return 0;
+    pthread_mutex_lock(&ingestor->mutex);
+    unsigned ready = ingestor->ready;
+    pthread_mutex_unlock(&ingestor->mutex);
+    return ready;
+}
+
+static void* load_in_background(void* arg) {
+    IngestTable* table = arg;
+    ensure_loaded(table->ingestor, table->index);
+    return NULL;
+}
+
+int ingestor_load_in_background(Ingestor* ingestor, unsigned tables) {
+    if (!ingestor) return -1;
+    
+    // One thread per table: independent tables load in parallel, the others
+    // wait inside ensure_loaded for the tables they reference
+    tables = with_dependencies(ingestor, tables);
+    int status = 0;
+    for (int i = 0; i < INGESTOR_TABLE_COUNT; i++) {
+        IngestTable* table = &ingestor->tables[i];
+        if (!(tables & (1u << i)) || table->has_loader) continue;
+        if (pthread_create(&table->loader, NULL, load_in_background, table) == 0) {
+            table->has_loader = true;
+        } else if (ensure_loaded(ingestor, i) != 0) {
+            // No thread: load in the foreground instead
+            status = -1;
+        }
+    }
+    return status;
+}
+
+void ingestor_wait(Ingestor* ingestor) {
+    if (!ingestor) return;
+    for (int i = 0; i < INGESTOR_TABLE_COUNT; i++) {
+        IngestTable* table = &ingestor->tables[i];
+        if (!table->has_loader) continue;
+        pthread_join(table->loader, NULL);
+        table->has_loader = false;
+    }
+}
+
+int ingestor_ingest_appended(Ingestor* ingestor) {
+    if (!ingestor) return -1;
+    
+    int new_rows = 0;
+    bool rewritten = false;
+    unsigned loaded = ingestor_loaded_tables(ingestor);
+    for (int i = 0; i < INGESTOR_TABLE_COUNT; i++) {
+        IngestTable* table = &ingestor->tables[i];
+        if (!(loaded & (1u << i))) continue;
+        int result = parse_table_resume(table->path, table->schema, ingestor->db,
+                                        table->error_log, &table->checkpoint);
+        if (result == PARSE_SOURCE_REWRITTEN) {
+            fprintf(stderr, "Warning: %s was rewritten, a full reload is needed\n", table->path);
+            rewritten = true;
+            continue;
+        }
+        new_rows += table->checkpoint.valid_count + table->checkpoint.error_count;
+    }
+    return rewritten ? -1 : new_rows;
+}
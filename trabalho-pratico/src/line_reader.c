@@ -0,0 +1,304 @@
+#include "../include/line_reader.h"
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#define LINE_READER_INITIAL_SIZE (64 * 1024)
+#define INFLATE_CHUNK_SIZE (128 * 1024)
+
+typedef struct line_reader {
+    FILE* fp;
+    char* buffer;         // block buffer, lines are returned in place
+    size_t capacity;      // allocated size (one byte is kept for the terminator)
+    size_t start;         // first byte of the next line
+    size_t end;           // end of the valid data
+    size_t scanned;       // bytes after `start` already known not to contain '\n'
+    bool eof;
+    bool failed;          // stopped early: a line outgrew memory or the source failed
+    off_t buffer_offset;  // file offset of buffer[0]
+    off_t line_offset;    // file offset of the last returned line
+    void (*discard_hook)(void* ctx, const char* buffer, off_t buffer_offset);
+    void* discard_ctx;
+    bool has_inflater;    // source is gzip, decompressed by `inflater`
+    pthread_t inflater;
+} LineReader;
+
+// Decompression thread state
+typedef struct {
+    gzFile gz;
+    int out_fd;           // write end of the pipe read by the LineReader
+} Inflater;
+
+// Decompresses the whole gzip stream into the pipe. Runs on its own thread
+// so decompression overlaps with parsing; the pipe bounds the data in flight.
+static void* inflate_thread(void* arg) {
+    Inflater* inflater = arg;
+    
+    // If the reader is closed early, write() fails with EPIPE instead of
+    // the process being killed by SIGPIPE
+    sigset_t block;
+    sigemptyset(&block);
+    sigaddset(&block, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &block, NULL);
+    
+    char* chunk = malloc(INFLATE_CHUNK_SIZE);
+    if (chunk) {
+        int n;
+        while ((n = gzread(inflater->gz, chunk, INFLATE_CHUNK_SIZE)) > 0) {
+            char* p = chunk;
+            while (n > 0) {
+                ssize_t written = write(inflater->out_fd, p, (size_t)n);
+                if (written <= 0) goto done;
+                p += written;
+                n -= (int)written;
+            }
+        }
+        if (n < 0) {
+            int errnum;
+            fprintf(stderr, "Failed to decompress: %s\n", gzerror(inflater->gz, &errnum));
+        }
+    }
+    
+done:
+    free(chunk);
+    gzclose(inflater->gz);
+    close(inflater->out_fd);
+    free(inflater);
+    return NULL;
+}
+
+// Opens a gzip file as a stream of decompressed bytes
+static FILE* open_gzip(const char* filepath, LineReader* reader) {
+    gzFile gz = gzopen(filepath, "rb");
+    if (!gz) return NULL;
+    gzbuffer(gz, INFLATE_CHUNK_SIZE);
+    
+    int fds[2];
+    Inflater* inflater = malloc(sizeof(Inflater));
+    if (!inflater || pipe(fds) != 0) {
+        free(inflater);
+        gzclose(gz);
+        return NULL;
+    }
+    inflater->gz = gz;
+    inflater->out_fd = fds[1];
+    
+    FILE* fp = fdopen(fds[0], "r");
+    if (!fp || pthread_create(&reader->inflater, NULL, inflate_thread, inflater) != 0) {
+        if (fp) fclose(fp); else close(fds[0]);
+        close(fds[1]);
+        gzclose(gz);
+        free(inflater);
+        return NULL;
+    }
+    reader->has_inflater = true;
+    return fp;
+}
+
+static bool has_suffix(const char* str, const char* suffix) {
+    size_t len = strlen(str), suffix_len = strlen(suffix);
+    return len >= suffix_len && strcmp(str + len - suffix_len, suffix) == 0;
+}
+
+bool line_reader_source(const char* filepath, char* path, size_t size, bool* compressed) {
+    if (!filepath || !path || !compressed) return false;
+    
+    *compressed = has_suffix(filepath, ".gz");
+    if (*compressed || access(filepath, R_OK) == 0) {
+        return snprintf(path, size, "%s", filepath) < (int)size;
+    }
+    if (snprintf(path, size, "%s.gz", filepath) >= (int)size || access(path, R_OK) != 0) return false;
+    *compressed = true;
+    return true;
+}
+
+off_t line_reader_source_size(const char* filepath) {
+    char path[1024];
+    bool compressed;
+    struct stat st;
+    if (!line_reader_source(filepath, path, sizeof(path), &compressed) || stat(path, &st) != 0) return -1;
+    if (!compressed) return st.st_size;
+    
+    // The gzip trailer ends with the uncompressed size modulo 4 GiB
+    // (little endian); the compressed size bounds it from below
+    off_t size = st.st_size;
+    FILE* fp = fopen(path, "rb");
+    if (!fp) return size;
+    unsigned char isize[4];
+    if (fseeko(fp, -4, SEEK_END) == 0 && fread(isize, 1, 4, fp) == 4) {
+        off_t trailer = (off_t)isize[0] | (off_t)isize[1] << 8 | (off_t)isize[2] << 16 | (off_t)isize[3] << 24;
+        if (trailer > size) size = trailer;
+    }
+    fclose(fp);
+    return size;
+}
+
+// Opens `filepath`, or `filepath.gz` if only the compressed file exists
+static FILE* open_source(const char* filepath, LineReader* reader) {
+    char path[1024];
+    bool compressed;
+    if (!line_reader_source(filepath, path, sizeof(path), &compressed)) return NULL;
+    return compressed ? open_gzip(path, reader) : fopen(path, "r");
+}
+
+LineReader* line_reader_open(const char* filepath) {
+    return line_reader_open_at(filepath, 0);
+}
+
+LineReader* line_reader_open_at(const char* filepath, off_t offset) {
+    LineReader* reader = malloc(sizeof(LineReader));
+    if (!reader) return NULL;
+    reader->has_inflater = false;
+    
+    FILE* fp = open_source(filepath, reader);
+    if (!fp) {
+        free(reader);
+        return NULL;
+    }
+    
+    if (offset > 0 && (reader->has_inflater || fseeko(fp, offset, SEEK_SET) != 0)) {
+        fclose(fp);
+        if (reader->has_inflater) pthread_join(reader->inflater, NULL);
+        free(reader);
+        return NULL;
+    }
+    
+    reader->buffer = malloc(LINE_READER_INITIAL_SIZE);
+    if (!reader->buffer) {
+        fclose(fp);
+        if (reader->has_inflater) pthread_join(reader->inflater, NULL);
+        free(reader);
+        return NULL;
+    }
+    
+    // Data goes straight from the kernel into our buffer
+    setvbuf(fp, NULL, _IONBF, 0);
+    
+    reader->fp = fp;
+    reader->capacity = LINE_READER_INITIAL_SIZE;
+    reader->start = 0;
+    reader->end = 0;
+    reader->scanned = 0;
+    reader->eof = false;
+    reader->failed = false;
+    reader->buffer_offset = offset;
+    reader->line_offset = offset;
+    reader->discard_hook = NULL;
+    reader->discard_ctx = NULL;
+    return reader;
+}
+
+void line_reader_close(LineReader* reader) {
+    if (!reader) return;
+    if (reader->discard_hook) {
+        reader->discard_hook(reader->discard_ctx, reader->buffer, reader->buffer_offset);
+    }
+    fclose(reader->fp);
+    if (reader->has_inflater) pthread_join(reader->inflater, NULL);
+    free(reader->buffer);
+    free(reader);
+}
+
+// Moves the pending partial line to the front, grows the buffer if that line
+// already fills it, and reads more data. Returns false if nothing was read.
+static bool refill(LineReader* reader) {
+    size_t pending = reader->end - reader->start;
+    
+    if (reader->discard_hook) {
+        reader->discard_hook(reader->discard_ctx, reader->buffer, reader->buffer_offset);
+    }
+    
+    if (reader->start > 0) {
+        memmove(reader->buffer, reader->buffer + reader->start, pending);
+        reader->buffer_offset += (off_t)reader->start;
+        reader->start = 0;
+        reader->end = pending;
+    }
+    
+    if (reader->end + 1 >= reader->capacity) {
+        size_t new_capacity = reader->capacity * 2;
+        char* grown = realloc(reader->buffer, new_capacity);
+        if (!grown) {
+            reader->failed = true;
+            return false;
+        }
+        reader->buffer = grown;
+        reader->capacity = new_capacity;
+    }
+    
+    size_t n = fread(reader->buffer + reader->end, 1, reader->capacity - 1 - reader->end, reader->fp);
+    if (n == 0) {
+        reader->eof = true;
+        reader->failed = ferror(reader->fp) != 0;
+        return false;
+    }
+    reader->end += n;
+    return true;
+}
+
+bool line_reader_next(LineReader* reader, char** line, size_t* length, bool* had_newline) {
+    if (!reader) return false;
+    
+    for (;;) {
+        char* begin = reader->buffer + reader->start;
+        size_t available = reader->end - reader->start;
+        char* newline = memchr(begin + reader->scanned, '\n', available - reader->scanned);
+        
+        if (newline) {
+            *newline = '\0';
+            *line = begin;
+            *length = (size_t)(newline - begin);
+            *had_newline = true;
+            reader->line_offset = reader->buffer_offset + (off_t)reader->start;
+            reader->start += *length + 1;
+            reader->scanned = 0;
+            return true;
+        }
+        
+        reader->scanned = available;
+        if (reader->eof || !refill(reader)) break;
+    }
+    
+    // The pending bytes are not known to be a whole line
+    if (reader->failed) return false;
+    
+    // Last line without a trailing '\n'
+    size_t available = reader->end - reader->start;
+    if (available == 0) return false;
+    
+    *line = reader->buffer + reader->start;
+    (*line)[available] = '\0';
+    *length = available;
+    *had_newline = false;
+    reader->line_offset = reader->buffer_offset + (off_t)reader->start;
+    reader->start = reader->end;
+    reader->scanned = 0;
+    return true;
+}
+
+bool line_reader_failed(const LineReader* reader) {
+    return reader && reader->failed;
+}
+
+off_t line_reader_line_offset(const LineReader* reader) {
+    return reader ? reader->line_offset : 0;
+}
+
+const char* line_reader_buffer(const LineReader* reader, off_t* buffer_offset) {
+    if (!reader) return NULL;
+    if (buffer_offset) *buffer_offset = reader->buffer_offset;
+    return reader->buffer;
+}
+
+void line_reader_set_discard_hook(LineReader* reader,
+                                  void (*hook)(void* ctx, const char* buffer, off_t buffer_offset),
+                                  void* ctx) {
+    if (!reader) return;
+    reader->discard_hook = hook;
+    reader->discard_ctx = ctx;
+}
@@ -0,0 +1,129 @@
+#include "../include/live_ingest.h"
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#define EVENT_BUFFER_SIZE 4096
+
+typedef struct live_ingest {
+    Ingestor* ingestor;
+    int inotify_fd;
+    int stop_pipe[2];            // written once by live_ingest_stop to wake the watcher
+    pthread_t thread;
+    pthread_rwlock_t lock;       // readers: queries, writer: one ingestion round
+} LiveIngest;
+
+// Drains the pending inotify events; true if one of them concerns a CSV
+// file (the directory may also hold unrelated files). Changes to .csv.gz
+// files are ignored: a live run only has plain CSV tables, since the
+// ingestor refuses compressed ones when rows may be appended.
+static bool drain_events(int fd) {
+    char buffer[EVENT_BUFFER_SIZE] __attribute__((aligned(__alignof__(struct inotify_event))));
+    bool relevant = false;
+    
+    ssize_t n;
+    while ((n = read(fd, buffer, sizeof(buffer))) > 0) {
+        for (char* p = buffer; p < buffer + n; ) {
+            const struct inotify_event* event = (const struct inotify_event*)p;
+            if (event->len > 0) {
+                const char* dot = strrchr(event->name, '.');
+                if (dot && (strcmp(dot, ".csv") == 0)) relevant = true;
+            }
+            p += sizeof(struct inotify_event) + event->len;
+        }
+    }
+    return relevant;
+}
+
+static void ingest_round(LiveIngest* live) {
+    pthread_rwlock_wrlock(&live->lock);
+    ingestor_ingest_appended(live->ingestor);
+    pthread_rwlock_unlock(&live->lock);
+}
+
+static void* watch_dataset(void* arg) {
+    LiveIngest* live = arg;
+    struct pollfd fds[2] = {
+        { .fd = live->inotify_fd, .events = POLLIN },
+        { .fd = live->stop_pipe[0], .events = POLLIN },
+    };
+    
+    // Rows appended between the initial load and the watch being installed
+    ingest_round(live);
+    
+    for (;;) {
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (fds[1].revents) break;
+        
+        // One round covers every event drained here; appends that land
+        // while it runs raise new events and trigger the next round
+        if ((fds[0].revents & POLLIN) && drain_events(live->inotify_fd)) {
+            ingest_round(live);
+        }
+    }
+    return NULL;
+}
+
+LiveIngest* live_ingest_start(Ingestor* ingestor, const char* dataset_path) {
+    if (!ingestor || !dataset_path) return NULL;
+    
+    LiveIngest* live = calloc(1, sizeof(LiveIngest));
+    if (!live) return NULL;
+    live->ingestor = ingestor;
+    live->stop_pipe[0] = live->stop_pipe[1] = -1;
+    
+    live->inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (live->inotify_fd < 0 ||
+        inotify_add_watch(live->inotify_fd, dataset_path,
+                          IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0 ||
+        pipe(live->stop_pipe) != 0) {
+        fprintf(stderr, "Failed to watch %s\n", dataset_path);
+        if (live->inotify_fd >= 0) close(live->inotify_fd);
+        if (live->stop_pipe[0] >= 0) close(live->stop_pipe[0]);
+        if (live->stop_pipe[1] >= 0) close(live->stop_pipe[1]);
+        free(live);
+        return NULL;
+    }
+    
+    pthread_rwlock_init(&live->lock, NULL);
+    
+    if (pthread_create(&live->thread, NULL, watch_dataset, live) != 0) {
+        pthread_rwlock_destroy(&live->lock);
+        close(live->inotify_fd);
+        close(live->stop_pipe[0]);
+        close(live->stop_pipe[1]);
+        free(live);
+        return NULL;
+    }
+    return live;
+}
+
+void live_ingest_stop(LiveIngest* live) {
+    if (!live) return;
+    
+    ssize_t written = write(live->stop_pipe[1], "x", 1);
+    (void)written;
+    pthread_join(live->thread, NULL);
+    
+    pthread_rwlock_destroy(&live->lock);
+    close(live->inotify_fd);
+    close(live->stop_pipe[0]);
+    close(live->stop_pipe[1]);
+    free(live);
+}
+
+void live_ingest_read_begin(LiveIngest* live) {
+    pthread_rwlock_rdlock(&live->lock);
+}
+
+void live_ingest_read_end(LiveIngest* live) {
+    pthread_rwlock_unlock(&live->lock);
+}
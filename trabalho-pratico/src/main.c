@@ -1,144 +1,243 @@
 #include "../include/database.h"
 #include "../include/controller.h"
-#include "../include/parser_airports.h"
-#include "../include/parser_aircrafts.h"
-#include "../include/parser_flights.h"
-#include "../include/parser_passengers.h"
-#include "../include/parser_reservations.h"
+#include "../include/ingestor.h"
+#include "../include/live_ingest.h"
+#include "../include/dataset_profile.h"
+#include "../include/query_pool.h"
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 
+// Executes a query into resultados/command<query_num>_output.txt, as a
+// reader of the live dataset if `watcher` is set, announcing it on stdout
+// if `announce` is set. False if the file could not be created.
+static bool execute_into_file(Controller* ctrl, const CompiledQuery* query, int query_num,
+                              LiveIngest* watcher, bool announce) {
+    char output_path[256];
+    snprintf(output_path, sizeof(output_path), 
+             "resultados/command%d_output.txt", query_num);
+    
+    FILE* output = fopen(output_path, "w");
+    if (!output) {
+        fprintf(stderr, "Failed to create output file: %s\n", output_path);
+        return false;
+    }
+    
+    if (announce) printf("Executing Line %d: %s", query_num, query->line);
+    if (watcher) live_ingest_read_begin(watcher);
+    controller_execute_compiled(ctrl, query, output);
+    if (watcher) live_ingest_read_end(watcher);
+    fclose(output);
+    return true;
+}
+
+// Queries of a plain run, executed on the query pool
+typedef struct {
+    Controller* ctrl;
+    Ingestor* ingestor;
+    const QueryPlan* plan;
+    bool* executed;            // executed[i]: the output file of query i was written
+} PlannedRun;
+
+static void run_planned(void* context, size_t index) {
+    PlannedRun* run = context;
+    const CompiledQuery* query = query_plan_get(run->plan, index);
+    ingestor_load_tables(run->ingestor, controller_query_tables(query));
+    run->executed[index] = execute_into_file(run->ctrl, query, (int)index + 1, NULL, false);
+}
+
+// Progress is reported in input order, as each query is done
+static void report_planned(void* context, size_t index) {
+    PlannedRun* run = context;
+    if (run->executed[index]) {
+        printf("Executing Line %d: %s", (int)index + 1, query_plan_get(run->plan, index)->line);
+    }
+}
+
 int main(int argc, char* argv[]) {
-    if (argc != 3) {
-        fprintf(stderr, "Usage: %s <dataset_path> <input_file>\n", argv[0]);
+    // --validate-only: only produce the error logs, the input file is optional
+    // --incremental: before each query, ingest the rows appended to the dataset
+    // --live: keep ingesting appended rows in the background while queries run
+    //         (the input file may be a FIFO fed over time)
+    bool validate_only = false;
+    bool incremental = false;
+    bool live = false;
+    int first_arg = 1;
+    if (argc > 1 && strcmp(argv[1], "--validate-only") == 0) {
+        validate_only = true;
+        first_arg = 2;
+    } else if (argc > 1 && strcmp(argv[1], "--incremental") == 0) {
+        incremental = true;
+        first_arg = 2;
+    } else if (argc > 1 && strcmp(argv[1], "--live") == 0) {
+        live = true;
+        first_arg = 2;
+    }
+    int positional = argc - first_arg;
+    
+    if (validate_only ? (positional < 1 || positional > 2) : positional != 2) {
+        fprintf(stderr, "Usage: %s [--validate-only | --incremental | --live] <dataset_path> <input_file>\n", argv[0]);
         fprintf(stderr, "Example: %s dataset/ input.txt\n", argv[0]);
+        fprintf(stderr, "         %s --validate-only dataset/\n", argv[0]);
         return 1;
     }
     
-    const char* dataset_path = argv[1];
-    const char* input_file = argv[2];
+    const char* dataset_path = argv[first_arg];
+    const char* input_file = positional > 1 ? argv[first_arg + 1] : NULL;
     
     printf("=== Airport Management System - Phase 1 ===\n");
     printf("Dataset path: %s\n", dataset_path);
-    printf("Input file: %s\n\n", input_file);
+    if (validate_only) {
+        printf("Mode: validate only\n\n");
+    } else if (incremental || live) {
+        printf("Input file: %s\nMode: %s\n\n", input_file, live ? "live" : "incremental");
+    } else {
+        printf("Input file: %s\n\n", input_file);
+    }
     
     // Create resultados directory if it doesn't exist
     mkdir("resultados", 0755);
     
     // Create database
     printf("Initializing database...\n");
-    Database* db = database_create();
+    // A profile written by programa-perfil pre-sizes every table
+    char profile_path[512];
+    snprintf(profile_path, sizeof(profile_path), "%s/%s", dataset_path, DATASET_PROFILE_FILE);
+    DatabaseSizing sizing;
+    bool sized = !validate_only && dataset_profile_load_sizing(profile_path, &sizing);
+    if (sized) printf("Table sizes from %s\n", profile_path);
+    Database* db = validate_only ? database_create_keys_only() : database_create_sized(sized ? &sizing : NULL);
     if (!db) {
         fprintf(stderr, "Failed to create database\n");
         return 1;
     }
     
-    // Build file paths
-    char airports_path[512], aircrafts_path[512], passengers_path[512];
-    char flights_path[512], reservations_path[512];
-    
-    snprintf(airports_path, sizeof(airports_path), "%s/airports.csv", dataset_path);
-    snprintf(aircrafts_path, sizeof(aircrafts_path), "%s/aircrafts.csv", dataset_path);
-    snprintf(passengers_path, sizeof(passengers_path), "%s/passengers.csv", dataset_path);
-    snprintf(flights_path, sizeof(flights_path), "%s/flights.csv", dataset_path);
-    snprintf(reservations_path, sizeof(reservations_path), "%s/reservations.csv", dataset_path);
-    
-    // Open error log files
-    FILE* airports_errors = fopen("resultados/airports_errors.csv", "w");
-    FILE* aircrafts_errors = fopen("resultados/aircrafts_errors.csv", "w");
-    FILE* passengers_errors = fopen("resultados/passengers_errors.csv", "w");
-    FILE* flights_errors = fopen("resultados/flights_errors.csv", "w");
-    FILE* reservations_errors = fopen("resultados/reservations_errors.csv", "w");
-    
-    if (!airports_errors || !aircrafts_errors || !passengers_errors || 
-        !flights_errors || !reservations_errors) {
-        fprintf(stderr, "Failed to create error log files\n");
+    // Open error logs and load the tables in dependency order
+    Ingestor* ingestor = ingestor_create(dataset_path, "resultados", db, incremental || live);
+    if (!ingestor) {
+        fprintf(stderr, "Failed to set up the dataset tables\n");
         database_destroy(db);
         return 1;
     }
     
-    // Parse CSV files in order based on dependencies
-    printf("\n=== Loading Data ===\n");
-    
-    printf("Loading airports...\n");
-    if (parse_airports(airports_path, db, airports_errors) != 0) {
-        fprintf(stderr, "Warning: Issues loading airports\n");
-    }
+    // Plain runs load the tables on background threads and each query only
+    // waits for the tables it reads; the other modes need every table up front
+    bool progressive = !validate_only && !incremental && !live;
     
-    printf("Loading aircrafts...\n");
-    if (parse_aircrafts(aircrafts_path, db, aircrafts_errors) != 0) {
-        fprintf(stderr, "Warning: Issues loading aircrafts\n");
-    }
-    
-    printf("Loading passengers...\n");
-    if (parse_passengers(passengers_path, db, passengers_errors) != 0) {
-        fprintf(stderr, "Warning: Issues loading passengers\n");
-    }
-    
-    printf("Loading flights...\n");
-    if (parse_flights(flights_path, db, flights_errors) != 0) {
-        fprintf(stderr, "Warning: Issues loading flights\n");
+    printf("\n=== Loading Data ===\n");
+    if (progressive) {
+        ingestor_load_in_background(ingestor, INGEST_ALL);
+        printf("Tables load in the background, each query waits for the ones it reads\n\n");
+    } else {
+        ingestor_load_all(ingestor);
+        printf("\n=== Data Loading Complete ===\n\n");
     }
     
-    printf("Loading reservations...\n");
-    if (parse_reservations(reservations_path, db, reservations_errors) != 0) {
-        fprintf(stderr, "Warning: Issues loading reservations\n");
+    if (validate_only) {
+        printf("Error logs written to resultados/ directory.\n");
+        ingestor_destroy(ingestor);
+        database_destroy(db);
+        return 0;
     }
     
-    // Close error logs
-    fclose(airports_errors);
-    fclose(aircrafts_errors);
-    fclose(passengers_errors);
-    fclose(flights_errors);
-    fclose(reservations_errors);
-    
-    printf("\n=== Data Loading Complete ===\n\n");
-    
     // Create controller
     Controller* ctrl = controller_create(db);
     if (!ctrl) {
         fprintf(stderr, "Failed to create controller\n");
+        ingestor_destroy(ingestor);
         database_destroy(db);
         return 1;
     }
     
+    // Start watching the dataset before waiting on the input (it may be a FIFO)
+    LiveIngest* watcher = NULL;
+    if (live) {
+        watcher = live_ingest_start(ingestor, dataset_path);
+        if (!watcher) {
+            controller_destroy(ctrl);
+            ingestor_destroy(ingestor);
+            database_destroy(db);
+            return 1;
+        }
+    }
+    
     // Execute queries from input file
     printf("=== Executing Queries ===\n");
     FILE* input = fopen(input_file, "r");
     if (!input) {
         fprintf(stderr, "Failed to open input file: %s\n", input_file);
+        live_ingest_stop(watcher);
         controller_destroy(ctrl);
+        ingestor_destroy(ingestor);
         database_destroy(db);
         return 1;
     }
     
-    char query[256];
     int query_num = 1;
     
-    while (fgets(query, sizeof(query), input)) {
-        // Skip empty lines
-        if (query[0] == '\n' || query[0] == '\0') continue;
+    if (!progressive) {
+        // The dataset changes while queries arrive: each one is executed
+        // as soon as it is read
+        char query[256];
+        while (fgets(query, sizeof(query), input)) {
+            // Skip empty lines
+            if (query[0] == '\n' || query[0] == '\0') continue;
+            
+            // Rows appended since the last query become visible to this one
+            if (incremental) ingestor_ingest_appended(ingestor);
+            
+            CompiledQuery compiled;
+            query_compile(query, &compiled);
+            execute_into_file(ctrl, &compiled, query_num++, watcher, true);
+        }
+    } else {
+        // Every query is parsed once, up front, and Q3 ranges are answered together
+        QueryPlan* plan = query_plan_read(input);
+        if (!plan) {
+            fprintf(stderr, "Failed to read input file: %s\n", input_file);
+            fclose(input);
+            ingestor_wait(ingestor);
+            controller_destroy(ctrl);
+            ingestor_destroy(ingestor);
+            database_destroy(db);
+            return 1;
+        }
         
-        char output_path[256];
-        snprintf(output_path, sizeof(output_path), 
-                 "resultados/command%d_output.txt", query_num);
+        size_t count = query_plan_count(plan);
+        for (size_t i = 0; i < count; i++) controller_plan_query(ctrl, query_plan_get(plan, i));
         
-        FILE* output = fopen(output_path, "w");
-        if (output) {
-            printf("Executing Line %d: %s", query_num, query);
-            controller_execute_query(ctrl, query, output);
-            fclose(output);
-        } else {
-            fprintf(stderr, "Failed to create output file: %s\n", output_path);
-        }
+        // The Q2 and Q3 indexes the plan reads are built while the rest
+        // of the tables load, instead of by the first query reading them
+        controller_prebuild_indexes(ctrl, plan, ingestor);
         
-        query_num++;
+        // Queries only read the database: with more than one core they run
+        // on a pool of workers, each as soon as the tables it reads are loaded
+        PlannedRun run = { ctrl, ingestor, plan, calloc(count ? count : 1, sizeof(bool)) };
+        int workers = query_pool_workers(count);
+        if (!run.executed || workers == 0 ||
+            !query_pool_run(count, workers, run_planned, report_planned, &run)) {
+            for (size_t i = 0; i < count; i++) {
+                const CompiledQuery* query = query_plan_get(plan, i);
+                ingestor_load_tables(ingestor, controller_query_tables(query));
+                execute_into_file(ctrl, query, (int)i + 1, NULL, true);
+            }
+        }
+        query_num += (int)count;
+        free(run.executed);
+        query_plan_destroy(plan);
     }
     
     fclose(input);
+    live_ingest_stop(watcher);
+    
+    // Tables no query needed still have to finish their error logs
+    if (progressive) {
+        ingestor_wait(ingestor);
+        printf("\n=== Data Loading Complete ===\n");
+    }
     
     printf("\n=== Done ===\n");
     printf("Executed %d queries.\n", query_num - 1);
@@ -146,6 +245,7 @@ int main(int argc, char* argv[]) {
     
     // Cleanup
     controller_destroy(ctrl);
+    ingestor_destroy(ingestor);
     database_destroy(db);
     
     return 0;
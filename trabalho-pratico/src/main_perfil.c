@@ -0,0 +1,69 @@
+#include "../include/dataset_profile.h"
+#include <stdio.h>
+#include <time.h>
+
+// Perfil rapido de um dataset: contagens, cardinalidades, comprimentos de
+// linha e intervalos de datas. O ficheiro gerado e lido pelo programa
+// principal para dimensionar as tabelas da base de dados.
+
+static double segundos_desde(const struct timespec* inicio) {
+    struct timespec agora;
+    clock_gettime(CLOCK_MONOTONIC, &agora);
+    return (double)(agora.tv_sec - inicio->tv_sec) + (double)(agora.tv_nsec - inicio->tv_nsec) / 1e9;
+}
+
+static void imprimir_tabela(const TableProfile* tabela) {
+    if (!tabela->found) {
+        printf("%s: ficheiro em falta\n", tabela->name);
+        return;
+    }
+    
+    printf("%s: %zu linhas, %zu chaves distintas\n", tabela->name, tabela->rows, tabela->keys);
+    for (int c = 0; c < tabela->column_count; c++) {
+        printf("  %-18s %zu valores distintos\n", tabela->columns[c].name, tabela->columns[c].distinct);
+    }
+    for (int d = 0; d < tabela->date_count; d++) {
+        const DateRangeProfile* intervalo = &tabela->dates[d];
+        if (intervalo->first) {
+            printf("  %-18s %s a %s\n", intervalo->name, intervalo->first, intervalo->last);
+        } else {
+            printf("  %-18s sem datas validas\n", intervalo->name);
+        }
+    }
+    printf("  comprimento        min %zu, p50 %zu, p99 %zu, max %zu bytes\n",
+           tabela->line_min, tabela->line_p50, tabela->line_p99, tabela->line_max);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 3) {
+        fprintf(stderr, "Uso: %s <caminho_dataset> [ficheiro_perfil]\n", argv[0]);
+        fprintf(stderr, "Por omissao o perfil e escrito em <caminho_dataset>/%s\n", DATASET_PROFILE_FILE);
+        return 1;
+    }
+    
+    char caminho_perfil[512];
+    if (argc == 3) {
+        snprintf(caminho_perfil, sizeof(caminho_perfil), "%s", argv[2]);
+    } else {
+        snprintf(caminho_perfil, sizeof(caminho_perfil), "%s/%s", argv[1], DATASET_PROFILE_FILE);
+    }
+    
+    struct timespec inicio;
+    clock_gettime(CLOCK_MONOTONIC, &inicio);
+    
+    DatasetProfile perfil;
+    if (!dataset_profile_scan(argv[1], &perfil)) {
+        fprintf(stderr, "Erro: nenhum ficheiro do dataset encontrado em %s\n", argv[1]);
+        return 1;
+    }
+    
+    printf("=== PERFIL DO DATASET ===\n");
+    for (int t = 0; t < PROFILE_TABLE_COUNT; t++) imprimir_tabela(&perfil.tables[t]);
+    
+    if (!dataset_profile_save(&perfil, caminho_perfil)) {
+        fprintf(stderr, "Erro ao escrever %s\n", caminho_perfil);
+        return 1;
+    }
+    printf("\nPerfil escrito em %s (%.3f s)\n", caminho_perfil, segundos_desde(&inicio));
+    return 0;
+}
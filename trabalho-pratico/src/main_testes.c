@@ -8,21 +8,34 @@
 #include "../include/parser_flights.h"
 #include "../include/parser_passengers.h"
 #include "../include/parser_reservations.h"
+#include "../include/testes_validadores.h"
+#include "../include/benchmark_ingestao.h"
+#include "../include/benchmark_topk.h"
+#include "../include/parse_stats.h"
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 
 int main(int argc, char* argv[]) {
+    // --benchmarks: medir também o top-k e a latência da ingestão contínua
+    int first_arg = 1;
+    bool benchmarks = false;
+    if (argc > 1 && strcmp(argv[1], "--benchmarks") == 0) {
+        benchmarks = true;
+        first_arg = 2;
+    }
+    
     // Verificar argumentos
-    if (argc != 4) {
-        fprintf(stderr, "Uso: %s <caminho_dataset> <ficheiro_comandos> <pasta_resultados_esperados>\n", argv[0]);
+    if (argc - first_arg != 3) {
+        fprintf(stderr, "Uso: %s [--benchmarks] <caminho_dataset> <ficheiro_comandos> <pasta_resultados_esperados>\n", argv[0]);
         fprintf(stderr, "Exemplo: %s dataset-erros/ input.txt resultados-esperados/\n", argv[0]);
         return 1;
     }
     
     // Configurar teste
-    TestConfig* config = create_test_config(argv[1], argv[2], argv[3], "resultados");
+    TestConfig* config = create_test_config(argv[first_arg], argv[first_arg + 1], argv[first_arg + 2], "resultados");
     
     if (!config) {
         fprintf(stderr, "Erro ao criar configuração de testes\n");
@@ -42,6 +55,30 @@ int main(int argc, char* argv[]) {
         return 1;
     }
     
+    // Validadores otimizados vs implementações de referência
+    if (run_validators_differential_test(200000, 2025) != 0) {
+        fprintf(stderr, "Erro: validadores divergem das implementacoes de referencia\n");
+        free_test_config(config);
+        return 1;
+    }
+    printf("\n");
+    
+    if (benchmarks) {
+        // Seleção top-k com chaves compactas vs qsort das queries
+        if (run_topk_benchmark(1000000, 2025) != 0) {
+            fprintf(stderr, "Erro: top-k diverge do ranking por qsort\n");
+            free_test_config(config);
+            return 1;
+        }
+        printf("\n");
+    
+        // Latência da ingestão contínua (informativo, não falha os testes)
+        if (run_live_ingest_benchmark(get_test_config_dataset_path(config)) == 0) {
+            printf("\n");
+        }
+        PARSE_STATS_RESET();   // a instrumentação só deve refletir o carregamento do dataset
+    }
+    
     // Contar comandos para estatística
     int total_commands = count_commands(get_test_config_input_file(config));
     if (total_commands > 0) {
@@ -61,6 +98,7 @@ int main(int argc, char* argv[]) {
     
     // Imprimir relatório final
     print_metrics_report(metrics);
+    print_parse_stats_report();
     
     // Libertar memória
     free_program_metrics(metrics);
@@ -1,4 +1,5 @@
 #include "../include/metricas.h"
+#include "../include/parse_stats.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -23,11 +24,26 @@ struct QueryStats {
     double avg_time;        // Tempo médio por teste
 };
 
+#define MAX_INDICES 8
+
+struct IndiceStats {
+    char nome[64];          // Nome do índice no controller
+    int construcoes;        // Vezes que foi construído
+    double tempo;           // Tempo total de construção em segundos
+    size_t custo;           // Custo estimado da última construção (linhas)
+};
+
 struct ProgramMetrics {
     struct QueryStats* query_stats; // Array de estatísticas por query
     int num_query_types;     // Número de tipos de query diferentes
     double total_execution_time; // Tempo total de execução
     long max_memory_usage;   // Pico de uso de memória
+    size_t cache_lookups;    // Queries procuradas na cache de resultados
+    size_t cache_hits;       // Queries respondidas pela cache
+    size_t alocacoes;        // Chamadas ao heap durante a execução das queries
+    size_t alocacoes_estaveis; // As mesmas, sem a primeira query de cada tipo
+    struct IndiceStats indices[MAX_INDICES]; // Índices construídos para as queries
+    int num_indices;
 };
 
 // Implementações simples usando apenas time.h
@@ -117,6 +133,11 @@ ProgramMetrics* init_program_metrics(int max_query_types) {
     metrics->num_query_types = 0;
     metrics->total_execution_time = 0.0;
     metrics->max_memory_usage = 0;
+    metrics->cache_lookups = 0;
+    metrics->cache_hits = 0;
+    metrics->alocacoes = 0;
+    metrics->alocacoes_estaveis = 0;
+    metrics->num_indices = 0;
     
     // Inicializar array de estatísticas
     for (int i = 0; i < max_query_types; i++) {
@@ -186,6 +207,30 @@ void set_program_metrics_total_time(ProgramMetrics* metrics, double total_time)
     }
 }
 
+void set_program_metrics_cache(ProgramMetrics* metrics, size_t lookups, size_t hits) {
+    if (metrics) {
+        metrics->cache_lookups = lookups;
+        metrics->cache_hits = hits;
+    }
+}
+
+void add_index_metrics(ProgramMetrics* metrics, const char* nome, int construcoes,
+                       double tempo, size_t custo) {
+    if (!metrics || !nome || metrics->num_indices >= MAX_INDICES) return;
+    struct IndiceStats* indice = &metrics->indices[metrics->num_indices++];
+    snprintf(indice->nome, sizeof(indice->nome), "%s", nome);
+    indice->construcoes = construcoes;
+    indice->tempo = tempo;
+    indice->custo = custo;
+}
+
+void set_program_metrics_alocacoes(ProgramMetrics* metrics, size_t total, size_t estaveis) {
+    if (metrics) {
+        metrics->alocacoes = total;
+        metrics->alocacoes_estaveis = estaveis;
+    }
+}
+
 void print_metrics_report(const ProgramMetrics* metrics) {
     if (!metrics) {
         return;
@@ -230,6 +275,28 @@ void print_metrics_report(const ProgramMetrics* metrics) {
         }
     }
     
+    // Imprimir taxa de acertos da cache de resultados
+    if (metrics->cache_lookups > 0) {
+        printf("Cache de resultados: %zu de %zu queries (%.1f%%)\n",
+               metrics->cache_hits, metrics->cache_lookups,
+               100.0 * metrics->cache_hits / metrics->cache_lookups);
+    }
+    
+    // Imprimir chamadas ao heap na fase de queries
+    printf("Alocacoes nas queries: %zu (%zu depois da primeira query de cada tipo)\n",
+           metrics->alocacoes, metrics->alocacoes_estaveis);
+    
+    // Imprimir construção dos índices (só os que alguma query pediu)
+    for (int i = 0; i < metrics->num_indices; i++) {
+        const struct IndiceStats* indice = &metrics->indices[i];
+        if (indice->construcoes == 0) {
+            printf("Indice %s: nao construido\n", indice->nome);
+        } else {
+            printf("Indice %s: %d construcoes, %.1f ms (custo estimado %zu linhas)\n",
+                   indice->nome, indice->construcoes, indice->tempo * 1000.0, indice->custo);
+        }
+    }
+    
     printf("Tempo total: %.1fs\n", metrics->total_execution_time);
 }
 
@@ -240,4 +307,43 @@ void free_program_metrics(ProgramMetrics* metrics) {
         }
         free(metrics);
     }
-}
\ No newline at end of file
+}
+void print_parse_stats_report(void) {
+#ifdef PARSE_STATS
+    static const char* stage_names[STAGE_COUNT] = {
+        "leitura", "divisao", "validacao", "referencias", "criacao", "insercao", "log de erros", "espera"
+    };
+    static const char* field_rule_names[FIELD_RULE_COUNT] = { "em falta", "invalido", "sem referencia" };
+    
+    printf("\n=== INSTRUMENTACAO DOS PARSERS ===\n");
+    for (int t = 0; t < parse_stats_table_count(); t++) {
+        const ParseTableStats* stats = parse_stats_table(t);
+        printf("%s: %llu linhas\n", stats->table_name, (unsigned long long)stats->rows);
+        
+        // Tempo por etapa
+        uint64_t total_ns = 0;
+        for (int s = 0; s < STAGE_COUNT; s++) total_ns += stats->stage_ns[s];
+        for (int s = 0; s < STAGE_COUNT; s++) {
+            if (stats->stage_ns[s] == 0) continue;
+            printf("  %-13s %9.3f ms (%4.1f%%)\n", stage_names[s], stats->stage_ns[s] / 1e6,
+                   total_ns ? 100.0 * stats->stage_ns[s] / total_ns : 0.0);
+        }
+        
+        // Rejeições por regra
+        if (stats->short_rows > 0) {
+            printf("  rejeitadas: linha incompleta: %llu\n", (unsigned long long)stats->short_rows);
+        }
+        for (int f = 0; f < stats->field_count; f++) {
+            for (int r = 0; r < FIELD_RULE_COUNT; r++) {
+                if (stats->field_rejects[f][r] == 0) continue;
+                printf("  rejeitadas: %s %s: %llu\n", stats->field_names[f], field_rule_names[r],
+                       (unsigned long long)stats->field_rejects[f][r]);
+            }
+        }
+        for (int r = 0; r < stats->rule_count; r++) {
+            printf("  rejeitadas: %s: %llu\n", stats->rules[r].name,
+                   (unsigned long long)stats->rules[r].count);
+        }
+    }
+#endif
+}
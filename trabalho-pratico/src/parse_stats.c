@@ -0,0 +1,102 @@
+#include "../include/parse_stats.h"
+
+#ifdef PARSE_STATS
+
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
+static ParseTableStats tables[PARSE_STATS_MAX_TABLES];
+static int table_count = 0;
+static pthread_mutex_t registry_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// A pipelined load updates one table from several threads: counters are
+// bumped atomically, the registry and the rule list take the mutex
+static _Thread_local ParseTableStats* current = NULL;
+static _Thread_local uint64_t last_lap = 0;
+
+static void bump(uint64_t* counter, uint64_t amount) {
+    __atomic_fetch_add(counter, amount, __ATOMIC_RELAXED);
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+void parse_stats_begin(const TableSchema* schema) {
+    pthread_mutex_lock(&registry_mutex);
+    current = NULL;
+    for (int i = 0; i < table_count; i++) {
+        if (strcmp(tables[i].table_name, schema->table_name) == 0) current = &tables[i];
+    }
+    if (!current && table_count < PARSE_STATS_MAX_TABLES) {
+        current = &tables[table_count++];
+        current->table_name = schema->table_name;
+        current->field_count = schema->field_count < PARSE_STATS_MAX_FIELDS ?
+                               schema->field_count : PARSE_STATS_MAX_FIELDS;
+        for (int f = 0; f < current->field_count; f++) current->field_names[f] = schema->fields[f].name;
+    }
+    pthread_mutex_unlock(&registry_mutex);
+    last_lap = now_ns();
+}
+
+void parse_stats_end(void) {
+    current = NULL;
+}
+
+void parse_stats_lap(ParseStage stage) {
+    uint64_t now = now_ns();
+    if (current) bump(&current->stage_ns[stage], now - last_lap);
+    last_lap = now;
+}
+
+void parse_stats_row(void) {
+    if (current) bump(&current->rows, 1);
+}
+
+void parse_stats_short_row(void) {
+    if (current) bump(&current->short_rows, 1);
+}
+
+void parse_stats_field_reject(int field, FieldRule rule) {
+    if (current && field < current->field_count) bump(&current->field_rejects[field][rule], 1);
+}
+
+void parse_stats_rule_reject(const char* rule) {
+    if (!current) return;
+    // Rules are string literals: pointer comparison first, then by text
+    pthread_mutex_lock(&registry_mutex);
+    int i = 0;
+    while (i < current->rule_count &&
+           current->rules[i].name != rule && strcmp(current->rules[i].name, rule) != 0) {
+        i++;
+    }
+    if (i == current->rule_count && i < PARSE_STATS_MAX_RULES) {
+        current->rules[i].name = rule;
+        current->rule_count++;
+    }
+    if (i < current->rule_count) current->rules[i].count++;
+    pthread_mutex_unlock(&registry_mutex);
+}
+
+void parse_stats_reset(void) {
+    pthread_mutex_lock(&registry_mutex);
+    memset(tables, 0, sizeof(tables));
+    table_count = 0;
+    pthread_mutex_unlock(&registry_mutex);
+}
+
+int parse_stats_table_count(void) {
+    pthread_mutex_lock(&registry_mutex);
+    int count = table_count;
+    pthread_mutex_unlock(&registry_mutex);
+    return count;
+}
+
+const ParseTableStats* parse_stats_table(int index) {
+    return index >= 0 && index < parse_stats_table_count() ? &tables[index] : NULL;
+}
+
+#endif
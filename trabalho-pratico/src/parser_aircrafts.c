@@ -1,93 +1,58 @@
 #include "../include/parser_aircrafts.h"
-#include "../include/parser_utils.h"
+#include "../include/parser_engine.h"
+#include "../include/parse_stats.h"
 #include "../include/database.h"
 #include "../include/aircrafts.h"
 #include <stdio.h>
 #include <stdlib.h>
-#include <string.h>
 
-int parse_aircrafts(const char* filepath, Database* db, FILE* error_log) {
-    FILE* fp = fopen(filepath, "r");
-    if (!fp) {
-        fprintf(stderr, "Failed to open %s\n", filepath);
-        return -1;
-    }
+static const FieldSpec AIRCRAFT_FIELDS[] = {
+    { "identifier",   true, NULL, NULL },
+    { "manufacturer", true, NULL, NULL },
+    { "model",        true, NULL, NULL },
+    { "year",         true, NULL, NULL },
+    { "capacity",     true, NULL, NULL },
+    { "range",        true, NULL, NULL },
+};
+
+static bool load_aircraft(const ParsedRow* row, Database* db) {
+    char** fields = row->fields;
     
-    char line[2048];
-    char original_line[2048];
+    // Parse numeric fields
+    int year = atoi(fields[3]);
+    int capacity = atoi(fields[4]);
+    int range = atoi(fields[5]);
     
-    // Write header to error log
-    if (error_log && fgets(line, sizeof(line), fp)) {
-        fprintf(error_log, "%s", line);
+    // Validate ranges
+    if (year < 1900 || year > 2025) return PARSE_REJECT("year out of range");
+    if (capacity <= 0) return PARSE_REJECT("capacity not positive");
+    if (range <= 0) return PARSE_REJECT("range not positive");
+    PARSE_STATS_LAP(STAGE_VALIDATE);
+    
+    // Create aircraft (only the ID in validation-only mode)
+    Aircraft* aircraft;
+    if (database_is_keys_only(db)) {
+        aircraft = aircraft_create(fields[0], NULL, NULL, year, capacity, range);
     } else {
-        fclose(fp);
-        return -1;
+        aircraft = aircraft_create(fields[0], fields[1], fields[2], year, capacity, range);
     }
+    if (!aircraft) return PARSE_REJECT("out of memory");
+    PARSE_STATS_LAP(STAGE_CREATE);
     
-    int valid_count = 0;
-    int error_count = 0;
-    
-    while (fgets(line, sizeof(line), fp)) {
-        strcpy(original_line, line);
-        line[strcspn(line, "\n")] = 0;
-        
-        // Parse CSV line with quoted fields
-        char* fields[6];
-        int field_count = parse_csv_line(line, fields, 6);
-        
-        if (field_count < 6) {
-            if (error_log) fprintf(error_log, "%s\n", original_line);
-            error_count++;
-            continue;
-        }
-        
-        char* id = fields[0];
-        char* manufacturer = fields[1];
-        char* model = fields[2];
-        char* year_str = fields[3];
-        char* capacity_str = fields[4];
-        char* range_str = fields[5];
-        
-        // Validate required fields
-        if (is_empty_field(id) || is_empty_field(manufacturer) || 
-            is_empty_field(model) || is_empty_field(year_str) ||
-            is_empty_field(capacity_str) || is_empty_field(range_str)) {
-            if (error_log) fprintf(error_log, "%s\n", original_line);
-            error_count++;
-            continue;
-        }
-        
-        // Parse numeric fields
-        int year = atoi(year_str);
-        int capacity = atoi(capacity_str);
-        int range = atoi(range_str);
-        
-        // Validate ranges
-        if (year < 1900 || year > 2025 || capacity <= 0 || range <= 0) {
-            if (error_log) fprintf(error_log, "%s\n", original_line);
-            error_count++;
-            continue;
-        }
-        
-        // Create aircraft
-        Aircraft* aircraft = aircraft_create(id, manufacturer, model, 
-                                            year, capacity, range);
-        if (aircraft) {
-            if (database_add_aircraft(db, aircraft) == 0) {
-                valid_count++;
-            } else {
-                // Duplicate ID
-                if (error_log) fprintf(error_log, "%s\n", original_line);
-                aircraft_destroy(aircraft);
-                error_count++;
-            }
-        } else {
-            if (error_log) fprintf(error_log, "%s\n", original_line);
-            error_count++;
-        }
+    int added = database_add_aircraft(db, aircraft);
+    PARSE_STATS_LAP(STAGE_INSERT);
+    if (added != 0) {
+        // Duplicate ID
+        aircraft_destroy(aircraft);
+        return PARSE_REJECT("duplicate identifier");
     }
-    
-    fclose(fp);
-    printf("Aircrafts: %d valid, %d errors\n", valid_count, error_count);
-    return 0;
+    return true;
+}
+
+const TableSchema AIRCRAFTS_SCHEMA = {
+    "Aircrafts", 6, AIRCRAFT_FIELDS, load_aircraft, NULL, NULL
+};
+
+int parse_aircrafts(const char* filepath, Database* db, FILE* error_log) {
+    return parse_table(filepath, &AIRCRAFTS_SCHEMA, db, error_log);
 }
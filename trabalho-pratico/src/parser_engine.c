@@ -0,0 +1,268 @@
+#include "../include/parser_engine.h"
+#include "../include/parser_utils.h"
+#include "../include/line_reader.h"
+#include "../include/reject_log.h"
+#include "../include/parse_stats.h"
+#include "../include/ingest_pipeline.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+bool parser_check_fields(const TableSchema* schema, ParsedRow* row, Database* db) {
+    for (int i = 0; i < schema->field_count; i++) {
+        const FieldSpec* spec = &schema->fields[i];
+        const char* value = row->fields[i];
+
+        if (is_empty_field(value)) {
+            if (spec->required) {
+                PARSE_STATS_FIELD_REJECT(i, FIELD_MISSING);
+                return false;
+            }
+            row->refs[i] = NULL;
+            continue;
+        }
+
+        if (spec->validate && !spec->validate(value)) {
+            PARSE_STATS_FIELD_REJECT(i, FIELD_INVALID);
+            return false;
+        }
+
+        if (spec->lookup) {
+            PARSE_STATS_LAP(STAGE_VALIDATE);
+            row->refs[i] = spec->lookup(db, value);
+            PARSE_STATS_LAP(STAGE_LOOKUP);
+            if (!row->refs[i]) {
+                PARSE_STATS_FIELD_REJECT(i, FIELD_UNRESOLVED);
+                return false;
+            }
+        } else {
+            row->refs[i] = NULL;
+        }
+    }
+    return true;
+}
+
+// Reader hook: pending rejected rows must be written before their bytes
+// leave the reader's buffer
+static void flush_rejected_rows(void* ctx, const char* buffer, off_t buffer_offset) {
+    reject_log_flush((RejectLog*)ctx, buffer, buffer_offset);
+}
+
+// Rejected rows are only recorded as source ranges; they are written in
+// batches when the log fills up or the reader discards its buffer
+static void log_rejected_row(RejectLog* rejects, LineReader* reader, size_t length, bool had_newline) {
+    reject_log_record(rejects, line_reader_line_offset(reader), length, had_newline);
+    if (reject_log_full(rejects)) {
+        off_t buffer_offset;
+        const char* buffer = line_reader_buffer(reader, &buffer_offset);
+        reject_log_flush(rejects, buffer, buffer_offset);
+    }
+}
+
+#define FINGERPRINT_WINDOW 4096
+
+// FNV-1a over the first and last FINGERPRINT_WINDOW bytes of [0, offset):
+// catches files that were replaced or rewritten instead of appended to
+static uint64_t fingerprint_source(const char* filepath, off_t offset) {
+    uint64_t hash = 1469598103934665603ULL ^ (uint64_t)offset;
+    if (offset == 0) return hash;
+
+    FILE* fp = fopen(filepath, "rb");
+    if (!fp) return 0;
+
+    unsigned char window[FINGERPRINT_WINDOW];
+    off_t starts[2] = { 0, offset > FINGERPRINT_WINDOW ? offset - FINGERPRINT_WINDOW : 0 };
+    for (int w = 0; w < 2; w++) {
+        size_t wanted = offset < FINGERPRINT_WINDOW ? (size_t)offset : FINGERPRINT_WINDOW;
+        if (fseeko(fp, starts[w], SEEK_SET) != 0) break;
+        size_t n = fread(window, 1, wanted, fp);
+        for (size_t i = 0; i < n; i++) {
+            hash ^= window[i];
+            hash *= 1099511628211ULL;
+        }
+    }
+
+    fclose(fp);
+    return hash;
+}
+
+int parse_table(const char* filepath, const TableSchema* schema, Database* db, FILE* error_log) {
+    TableCheckpoint checkpoint = { 0 };
+    return parse_table_resume(filepath, schema, db, error_log, &checkpoint);
+}
+
+int parse_table_resume(const char* filepath, const TableSchema* schema, Database* db,
+                       FILE* error_log, TableCheckpoint* checkpoint) {
+    if (!schema || !checkpoint || schema->field_count > PARSER_MAX_FIELDS) return -1;
+
+    bool resuming = checkpoint->offset > 0;
+    checkpoint->valid_count = 0;
+    checkpoint->error_count = 0;
+
+    // The consumed prefix must be untouched since the last round. Only a
+    // plain CSV can be checked and read from an offset.
+    if (resuming) {
+        char source[1024];
+        bool compressed;
+        if (line_reader_source(filepath, source, sizeof(source), &compressed) && compressed) {
+            fprintf(stderr, "Cannot read rows appended to %s: it is compressed\n", source);
+            return -1;
+        }
+        struct stat st;
+        if (stat(filepath, &st) != 0) {
+            fprintf(stderr, "Failed to open %s\n", filepath);
+            return -1;
+        }
+        if (st.st_size == checkpoint->offset) return 0;   // nothing appended
+        if (st.st_size < checkpoint->offset ||
+            fingerprint_source(filepath, checkpoint->offset) != checkpoint->fingerprint) {
+            return PARSE_SOURCE_REWRITTEN;
+        }
+    }
+
+    LineReader* reader = line_reader_open_at(filepath, checkpoint->offset);
+    if (!reader) {
+        fprintf(stderr, "Failed to open %s\n", filepath);
+        return -1;
+    }
+
+    char* line;
+    size_t length;
+    bool had_newline;
+    off_t consumed = checkpoint->offset;
+
+    // Write header to error log
+    if (!resuming) {
+        if (error_log && line_reader_next(reader, &line, &length, &had_newline)) {
+            fwrite(line, 1, length, error_log);
+            if (had_newline) fputc('\n', error_log);
+            consumed = (off_t)(length + had_newline);
+        } else {
+            line_reader_close(reader);
+            return -1;
+        }
+    }
+
+    RejectLog* rejects = reject_log_create(error_log);
+    if (!rejects) {
+        line_reader_close(reader);
+        return -1;
+    }
+    line_reader_set_discard_hook(reader, flush_rejected_rows, rejects);
+
+    int valid_count = 0;
+    int error_count = 0;
+    char* fields[PARSER_MAX_FIELDS];
+    ParsedRow row = { .fields = fields };
+    PARSE_STATS_BEGIN(schema);
+    if (schema->prepare) row.context = schema->prepare(filepath, checkpoint->offset, db);
+    PARSE_STATS_LAP(STAGE_LOOKUP);
+
+    // Splitting is destructive, so it works on a copy; the original stays
+    // in the reader's buffer for the error log. Grows with the longest row,
+    // padded for the *_padded validators.
+    size_t split_capacity = 4096;
+    char* split = malloc(split_capacity + FIELD_PADDING);
+    if (!split) {
+        line_reader_close(reader);
+        reject_log_destroy(rejects);
+        if (row.context) schema->release(row.context);
+        PARSE_STATS_END();
+        return -1;
+    }
+
+    // Large sources on a multi-core machine go through the threaded
+    // pipeline; the serial loop below covers everything else
+    bool pipelined = false;
+    bool pipeline_failed = false;
+    int validators = ingest_pipeline_validators(filepath, consumed);
+    if (validators > 0) {
+        // The pipeline keeps its own copy of every row for the error log
+        line_reader_set_discard_hook(reader, NULL, NULL);
+        PipelineResult result;
+        pipelined = ingest_pipeline_run(reader, schema, db, rejects, checkpoint->complete_lines_only,
+                                        row.context, consumed, validators, &result);
+        if (pipelined) {
+            valid_count = result.valid_count;
+            error_count = result.error_count;
+            consumed = result.consumed;
+            pipeline_failed = result.failed;
+        } else {
+            line_reader_set_discard_hook(reader, flush_rejected_rows, rejects);
+        }
+    }
+
+    while (!pipelined && line_reader_next(reader, &line, &length, &had_newline)) {
+        // A writer may still be appending to an unterminated last line
+        if (!had_newline && checkpoint->complete_lines_only) break;
+        PARSE_STATS_LAP(STAGE_READ);
+        PARSE_STATS_ROW();
+        consumed = line_reader_line_offset(reader) + (off_t)(length + had_newline);
+
+        if (length + 1 > split_capacity) {
+            size_t new_capacity = split_capacity;
+            while (length + 1 > new_capacity) new_capacity *= 2;
+            char* grown = realloc(split, new_capacity + FIELD_PADDING);
+            if (!grown) {
+                log_rejected_row(rejects, reader, length, had_newline);
+                PARSE_STATS_LAP(STAGE_LOG);
+                error_count++;
+                row.index++;
+                continue;
+            }
+            split = grown;
+            split_capacity = new_capacity;
+        }
+        memcpy(split, line, length + 1);
+
+        // Parse CSV line with quoted fields
+        int field_count = parse_csv_line(split, fields, schema->field_count);
+        PARSE_STATS_LAP(STAGE_SPLIT);
+        if (field_count < schema->field_count) PARSE_STATS_SHORT_ROW();
+
+        bool stored = field_count >= schema->field_count &&
+                      parser_check_fields(schema, &row, db) &&
+                      schema->load_row(&row, db);
+        PARSE_STATS_LAP(STAGE_VALIDATE);   // whatever load_row did not charge elsewhere
+
+        if (stored) {
+            valid_count++;
+        } else {
+            log_rejected_row(rejects, reader, length, had_newline);
+            PARSE_STATS_LAP(STAGE_LOG);
+            error_count++;
+        }
+        row.index++;
+    }
+
+    free(split);
+    if (row.context) schema->release(row.context);
+    bool read_failed = line_reader_failed(reader);
+    line_reader_close(reader);   // writes the remaining rejected rows
+    reject_log_destroy(rejects);
+    PARSE_STATS_LAP(STAGE_LOG);
+    PARSE_STATS_END();
+
+    checkpoint->offset = consumed;
+    checkpoint->fingerprint = fingerprint_source(filepath, consumed);
+    checkpoint->valid_count = valid_count;
+    checkpoint->error_count = error_count;
+
+    if (resuming) {
+        if (valid_count + error_count > 0) {
+            printf("%s: +%d valid, +%d errors\n", schema->table_name, valid_count, error_count);
+        }
+    } else {
+        printf("%s: %d valid, %d errors\n", schema->table_name, valid_count, error_count);
+    }
+    if (pipeline_failed) {
+        fprintf(stderr, "Out of memory buffering %s, stopped at byte %lld\n", filepath, (long long)consumed);
+        return -1;
+    }
+    if (read_failed) {
+        fprintf(stderr, "Failed reading %s, stopped at byte %lld\n", filepath, (long long)consumed);
+        return -1;
+    }
+    return 0;
+}
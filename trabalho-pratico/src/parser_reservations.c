@@ -1,227 +1,414 @@
 #include "../include/parser_reservations.h"
+#include "../include/parser_engine.h"
 #include "../include/parser_utils.h"
+#include "../include/parse_stats.h"
 #include "../include/database.h"
 #include "../include/reservations.h"
 #include "../include/flights.h"
+#include "../include/line_reader.h"
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
 
-int parse_reservations(const char* filepath, Database* db, FILE* error_log) {
-    FILE* fp = fopen(filepath, "r");
-    if (!fp) {
-        fprintf(stderr, "Failed to open %s\n", filepath);
-        return -1;
+enum {
+    RESERVATION_ID, RESERVATION_FLIGHT_IDS, RESERVATION_DOCUMENT_NUMBER,
+    RESERVATION_SEAT, RESERVATION_PRICE, RESERVATION_EXTRA_LUGGAGE,
+    RESERVATION_PRIORITY_BOARDING, RESERVATION_QR_CODE,
+    RESERVATION_FIELD_COUNT
+};
+
+static const FieldSpec RESERVATION_FIELDS[RESERVATION_FIELD_COUNT] = {
+    [RESERVATION_ID]                = { "id",                true,  validate_reservation_id_padded,  NULL },
+    [RESERVATION_FLIGHT_IDS]        = { "flight_ids",        true,  NULL,                            NULL },
+    [RESERVATION_DOCUMENT_NUMBER]   = { "document_number",   true,  validate_document_number_padded, NULL },
+    [RESERVATION_SEAT]              = { "seat",              false, NULL,                            NULL },
+    [RESERVATION_PRICE]             = { "price",             true,  NULL,                            NULL },
+    [RESERVATION_EXTRA_LUGGAGE]     = { "extra_luggage",     false, NULL,                            NULL },
+    [RESERVATION_PRIORITY_BOARDING] = { "priority_boarding", false, NULL,                            NULL },
+    [RESERVATION_QR_CODE]           = { "qr_code",           false, NULL,                            NULL },
+};
+
+// Splits the flight list in place ("['AB12345', 'CD67890']" or a bare ID).
+// Returns the number of IDs, 0 if the list is invalid. Items beyond the
+// second are ignored.
+static size_t split_flight_list(char* flight_ids_str, char* flight_ids[RESERVATION_MAX_FLIGHTS]) {
+    // Single flight (no brackets)
+    if (flight_ids_str[0] != '[') {
+        flight_ids[0] = flight_ids_str;
+        return 1;
     }
     
-    char line[2048];
-    char original_line[2048];
+    // Validate list format: must end with ]
+    size_t len = strlen(flight_ids_str);
+    if (len < 2 || flight_ids_str[len-1] != ']') return 0;
     
-    // Write header to error log
-    if (error_log && fgets(line, sizeof(line), fp)) {
-        fprintf(error_log, "%s", line);
-    } else {
-        fclose(fp);
-        return -1;
-    }
-    
-    int valid_count = 0;
-    int error_count = 0;
+    // Remove [ and ]
+    char* flight_list = flight_ids_str + 1;
+    flight_list[len-2] = '\0';
     
-    while (fgets(line, sizeof(line), fp)) {
-        strcpy(original_line, line);
-        line[strcspn(line, "\n")] = 0;
-        
-        // Parse CSV line with quoted fields
-        char* fields[8];
-        int field_count = parse_csv_line(line, fields, 8);
+    // Split by comma (empty items are skipped)
+    size_t flight_count = 0;
+    char* saveptr = NULL;
+    char* flight_id = strtok_r(flight_list, ",", &saveptr);
+    while (flight_id && flight_count < RESERVATION_MAX_FLIGHTS) {
+        // Trim whitespace
+        while (*flight_id == ' ') flight_id++;
+        char* end = flight_id + strlen(flight_id) - 1;
+        while (end > flight_id && *end == ' ') *end-- = '\0';
         
-        if (field_count < 8) {
-            if (error_log) fprintf(error_log, "%s\n", original_line);
-            error_count++;
-            continue;
+        // Remove single quotes if present
+        if (flight_id[0] == '\'' && end >= flight_id && *end == '\'') {
+            flight_id++;
+            *end = '\0';
         }
         
-        char* id = fields[0];
-        char* flight_ids_str = fields[1];
-        char* document_number = fields[2];
-        char* seat = fields[3];
-        char* price_str = fields[4];
-        char* extra_luggage_str = fields[5];
-        char* priority_boarding_str = fields[6];
-        char* qr_code = fields[7];
+        flight_ids[flight_count++] = flight_id;
+        flight_id = strtok_r(NULL, ",", &saveptr);
+    }
+    
+    return flight_count;
+}
+
+// ---------------------------------------------------------------------------
+// Bulk reference resolution
+//
+// On large files one hash probe per passenger and per flight reference is a
+// cache miss each. The pre-pass instead collects every reference as an
+// encoded integer, radix-sorts them and merge-joins them against the sorted
+// keys of the passengers and flights tables; load_row then only reads the
+// per-row verdicts, in file order.
+// ---------------------------------------------------------------------------
+
+#define BULK_MIN_BYTES (8L << 20)   // smaller files: probing is cheaper than the extra pass
+#define SLOT_BITS 34                // low bits of a packed reference: slot (row, item)
+#define SLOTS_PER_ROW (1 + RESERVATION_MAX_FLIGHTS)
+#define NO_KEY UINT32_MAX
+
+typedef struct {
+    size_t row_count;               // rows covered; later rows fall back to probes
+    void** resolved;                // per row: passenger, then each flight (NULL: not found)
+    uint8_t* flight_counts;         // per row, 0 if the list is invalid
+} BulkRefs;
+
+// Document numbers: 9 digits -> [0, 1e9). `doc` must already be valid.
+static uint32_t document_number_key(const char* doc) {
+    uint32_t key = 0;
+    for (int i = 0; i < 9; i++) key = key * 10 + (uint32_t)(doc[i] - '0');
+    return key;
+}
+
+// Flight IDs: 2 uppercase letters + 5 digits -> [0, 676e5). `id` must
+// already be valid.
+static uint32_t flight_id_key(const char* id) {
+    uint32_t key = (uint32_t)(id[0] - 'A') * 26 + (uint32_t)(id[1] - 'A');
+    for (int i = 2; i < 7; i++) key = key * 10 + (uint32_t)(id[i] - '0');
+    return key;
+}
+
+// Keys of the references in a row, which may be malformed
+static uint32_t encode_document_number(const char* doc) {
+    return validate_document_number(doc) ? document_number_key(doc) : NO_KEY;
+}
+
+static uint32_t encode_flight_id(const char* id) {
+    return validate_flight_id(id) ? flight_id_key(id) : NO_KEY;
+}
+
+typedef struct {
+    uint64_t* items;                // (key << SLOT_BITS) | slot
+    size_t count;
+    size_t capacity;
+} PackedKeys;
+
+static bool packed_push(PackedKeys* keys, uint32_t key, uint64_t slot) {
+    if (keys->count == keys->capacity) {
+        size_t new_capacity = keys->capacity ? keys->capacity * 2 : 4096;
+        uint64_t* grown = realloc(keys->items, new_capacity * sizeof(uint64_t));
+        if (!grown) return false;
+        keys->items = grown;
+        keys->capacity = new_capacity;
+    }
+    keys->items[keys->count++] = ((uint64_t)key << SLOT_BITS) | slot;
+    return true;
+}
+
+// LSD radix sort on the key bits, 8 bits per pass
+static bool radix_sort_keys(PackedKeys* keys) {
+    if (keys->count < 2) return true;
+    uint64_t* scratch = malloc(keys->count * sizeof(uint64_t));
+    if (!scratch) return false;
+    
+    uint64_t* from = keys->items;
+    uint64_t* to = scratch;
+    for (int shift = SLOT_BITS; shift < 64; shift += 8) {
+        size_t counts[256] = {0};
+        for (size_t i = 0; i < keys->count; i++) counts[(from[i] >> shift) & 0xFF]++;
         
-        // Validate required fields
-        if (is_empty_field(id) || is_empty_field(flight_ids_str) || 
-            is_empty_field(document_number) || is_empty_field(price_str)) {
-            if (error_log) fprintf(error_log, "%s\n", original_line);
-            error_count++;
-            continue;
+        size_t position = 0;
+        for (int b = 0; b < 256; b++) {
+            size_t c = counts[b];
+            counts[b] = position;
+            position += c;
         }
+        for (size_t i = 0; i < keys->count; i++) to[counts[(from[i] >> shift) & 0xFF]++] = from[i];
         
-        // Validate reservation ID
-        if (!validate_reservation_id(id)) {
-            if (error_log) fprintf(error_log, "%s\n", original_line);
-            error_count++;
-            continue;
+        uint64_t* swap = from;
+        from = to;
+        to = swap;
+    }
+    
+    // An odd number of passes leaves the result in scratch
+    if (from != keys->items) memcpy(keys->items, from, keys->count * sizeof(uint64_t));
+    free(scratch);
+    return true;
+}
+
+// Merge-join of sorted references against sorted table keys: every
+// reference whose key exists gets its entity in resolved[slot]
+static void merge_join(const PackedKeys* refs, const PackedKeys* table, void** entities, void** resolved) {
+    const uint64_t slot_mask = (1ULL << SLOT_BITS) - 1;
+    size_t j = 0;
+    for (size_t i = 0; i < refs->count; i++) {
+        uint64_t key = refs->items[i] >> SLOT_BITS;
+        while (j < table->count && (table->items[j] >> SLOT_BITS) < key) j++;
+        if (j == table->count) break;
+        if ((table->items[j] >> SLOT_BITS) == key) {
+            resolved[refs->items[i] & slot_mask] = entities[table->items[j] & slot_mask];
         }
-        
-        // Validate document number
-        if (!validate_document_number(document_number)) {
-            if (error_log) fprintf(error_log, "%s\n", original_line);
-            error_count++;
-            continue;
+    }
+}
+
+// Sorted keys of one table; entities[i] is the entity of index i
+static bool sorted_table_keys(void** entities, size_t count, uint32_t (*encode)(const void* entity),
+                              PackedKeys* keys) {
+    for (size_t i = 0; i < count; i++) {
+        uint32_t key = encode(entities[i]);
+        if (key != NO_KEY && !packed_push(keys, key, i)) return false;
+    }
+    return radix_sort_keys(keys);
+}
+
+// Stored entities passed validation when they were loaded
+static uint32_t passenger_key(const void* passenger) {
+    return document_number_key(passenger_get_document_number(passenger));
+}
+
+static uint32_t flight_key(const void* flight) {
+    return flight_id_key(flight_get_id(flight));
+}
+
+static void release_bulk_refs(void* context) {
+    BulkRefs* bulk = context;
+    if (!bulk) return;
+    free(bulk->resolved);
+    free(bulk->flight_counts);
+    free(bulk);
+}
+
+// First pass: collects the references of every row, in file order
+static bool collect_references(const char* filepath, off_t offset, BulkRefs* bulk,
+                               PackedKeys* documents, PackedKeys* flight_ids) {
+    LineReader* reader = line_reader_open_at(filepath, offset);
+    if (!reader) return false;
+    
+    char* line;
+    size_t length;
+    bool had_newline;
+    if (offset == 0 && !line_reader_next(reader, &line, &length, &had_newline)) {
+        line_reader_close(reader);
+        return false;
+    }
+    
+    size_t capacity = 0;
+    size_t split_capacity = 0;
+    char* split = NULL;
+    bool ok = true;
+    char* fields[RESERVATION_FIELD_COUNT];
+    
+    while (ok && line_reader_next(reader, &line, &length, &had_newline)) {
+        size_t row = bulk->row_count;
+        if (row == capacity) {
+            size_t new_capacity = capacity ? capacity * 2 : 4096;
+            void** resolved = realloc(bulk->resolved, new_capacity * SLOTS_PER_ROW * sizeof(void*));
+            if (resolved) bulk->resolved = resolved;
+            uint8_t* counts = realloc(bulk->flight_counts, new_capacity);
+            if (counts) bulk->flight_counts = counts;
+            if (!resolved || !counts) break;
+            capacity = new_capacity;
         }
-        
-        // Check if passenger exists
-        if (!database_get_passenger(db, document_number)) {
-            if (error_log) fprintf(error_log, "%s\n", original_line);
-            error_count++;
-            continue;
+        if (length + 1 > split_capacity) {
+            size_t new_capacity = split_capacity ? split_capacity : 4096;
+            while (length + 1 > new_capacity) new_capacity *= 2;
+            char* grown = realloc(split, new_capacity);
+            if (!grown) break;
+            split = grown;
+            split_capacity = new_capacity;
         }
+        memcpy(split, line, length + 1);
         
-        // Parse flight IDs (can be 1 or 2, must be in [list] format if multiple)
-        char* flight_ids[2] = {NULL, NULL};
-        size_t flight_count = 0;
+        void** resolved = &bulk->resolved[row * SLOTS_PER_ROW];
+        for (int k = 0; k < SLOTS_PER_ROW; k++) resolved[k] = NULL;
+        bulk->flight_counts[row] = 0;
         
-        // Check if it's a list (starts with [ and ends with ])
-        bool is_list = (flight_ids_str[0] == '[');
-        
-        if (is_list) {
-            // Validate list format
-            size_t len = strlen(flight_ids_str);
-            if (len < 2 || flight_ids_str[len-1] != ']') {
-                if (error_log) fprintf(error_log, "%s\n", original_line);
-                error_count++;
-                continue;
-            }
-            
-            // Remove [ and ]
-            char* flight_list = flight_ids_str + 1;
-            flight_list[len-2] = '\0';
+        if (parse_csv_line(split, fields, RESERVATION_FIELD_COUNT) >= RESERVATION_FIELD_COUNT) {
+            uint64_t slot = (uint64_t)row * SLOTS_PER_ROW;
+            uint32_t key = encode_document_number(fields[RESERVATION_DOCUMENT_NUMBER]);
+            if (key != NO_KEY) ok = packed_push(documents, key, slot);
             
-            // Split by comma
-            char* flight_id = strtok(flight_list, ",");
-            while (flight_id && flight_count < 2) {
-                // Trim whitespace
-                while (*flight_id == ' ') flight_id++;
-                char* end = flight_id + strlen(flight_id) - 1;
-                while (end > flight_id && *end == ' ') *end-- = '\0';
-                
-                // Remove single quotes if present
-                if (flight_id[0] == '\'' && end >= flight_id && *end == '\'') {
-                    flight_id++;
-                    *end = '\0';
-                }
-                
-                if (!validate_flight_id(flight_id)) {
-                    flight_count = 0;
-                    break;
-                }
-                // Check if flight exists
-                if (!database_get_flight(db, flight_id)) {
-                    flight_count = 0;
-                    break;
-                }
-                // Allocate and copy flight ID
-                flight_ids[flight_count] = strdup(flight_id);
-                if (!flight_ids[flight_count]) {
-                    flight_count = 0;
-                    break;
-                }
-                flight_count++;
-                flight_id = strtok(NULL, ",");
+            char* ids[RESERVATION_MAX_FLIGHTS];
+            size_t count = is_empty_field(fields[RESERVATION_FLIGHT_IDS]) ? 0 :
+                           split_flight_list(fields[RESERVATION_FLIGHT_IDS], ids);
+            bulk->flight_counts[row] = (uint8_t)count;
+            for (size_t k = 0; k < count && ok; k++) {
+                key = encode_flight_id(ids[k]);
+                if (key != NO_KEY) ok = packed_push(flight_ids, key, slot + 1 + k);
             }
-            
-            if (flight_count == 0 || flight_count > 2) {
-                if (error_log) fprintf(error_log, "%s\n", original_line);
-                error_count++;
-                continue;
-            }
-        } else {
-            // Single flight (no brackets)
-            if (!validate_flight_id(flight_ids_str)) {
-                if (error_log) fprintf(error_log, "%s\n", original_line);
-                error_count++;
-                continue;
-            }
-            // Check if flight exists
-            if (!database_get_flight(db, flight_ids_str)) {
-                if (error_log) fprintf(error_log, "%s\n", original_line);
-                error_count++;
-                continue;
-            }
-            // Allocate and copy flight ID
-            flight_ids[0] = strdup(flight_ids_str);
-            if (!flight_ids[0]) {
-                if (error_log) fprintf(error_log, "%s\n", original_line);
-                error_count++;
-                continue;
-            }
-            flight_count = 1;
         }
-        
-        // If 2 flights: validate connection (destination of first == origin of second)
-        if (flight_count == 2) {
-            Flight* flight1 = database_get_flight(db, flight_ids[0]);
-            Flight* flight2 = database_get_flight(db, flight_ids[1]);
-            
-            if (!flight1 || !flight2) {
-                if (error_log) fprintf(error_log, "%s\n", original_line);
-                error_count++;
-                continue;
-            }
-            
-            const char* dest1 = flight_get_destination(flight1);
-            const char* orig2 = flight_get_origin(flight2);
-            
-            if (strcmp(dest1, orig2) != 0) {
-                if (error_log) fprintf(error_log, "%s\n", original_line);
-                error_count++;
-                continue;
-            }
-        }
-        
-        // Parse price
-        double price = atof(price_str);
-        if (price < 0) {
-            if (error_log) fprintf(error_log, "%s\n", original_line);
-            error_count++;
-            continue;
+        bulk->row_count++;
+    }
+    
+    free(split);
+    ok = ok && !line_reader_failed(reader);
+    line_reader_close(reader);
+    return ok;
+}
+
+// Schema prepare hook: builds the per-row verdicts for large files
+static void* build_bulk_refs(const char* filepath, off_t offset, Database* db) {
+    off_t size = line_reader_source_size(filepath);
+    if (size < 0 || size - offset < BULK_MIN_BYTES) return NULL;
+    
+    BulkRefs* bulk = calloc(1, sizeof(BulkRefs));
+    PackedKeys documents = {0}, flight_ids = {0}, table = {0};
+    size_t passenger_count = 0, flight_count = 0;
+    Passenger** passengers = database_get_all_passengers(db, &passenger_count);
+    Flight** flights = database_get_all_flights(db, &flight_count);
+    
+    bool ok = bulk && collect_references(filepath, offset, bulk, &documents, &flight_ids) &&
+              radix_sort_keys(&documents) && radix_sort_keys(&flight_ids);
+    
+    if (ok) ok = sorted_table_keys((void**)passengers, passenger_count, passenger_key, &table);
+    if (ok) merge_join(&documents, &table, (void**)passengers, bulk->resolved);
+    table.count = 0;
+    if (ok) ok = sorted_table_keys((void**)flights, flight_count, flight_key, &table);
+    if (ok) merge_join(&flight_ids, &table, (void**)flights, bulk->resolved);
+    
+    free(documents.items);
+    free(flight_ids.items);
+    free(table.items);
+    free(passengers);
+    free(flights);
+    if (!ok) {
+        release_bulk_refs(bulk);
+        return NULL;
+    }
+    return bulk;
+}
+
+// Passenger reference: pre-pass verdict when available, hash probe otherwise
+static bool passenger_exists(const ParsedRow* row, Database* db) {
+    const BulkRefs* bulk = row->context;
+    bool found;
+    if (bulk && row->index < bulk->row_count) {
+        found = bulk->resolved[row->index * SLOTS_PER_ROW] != NULL;
+    } else {
+        found = database_get_passenger(db, row->fields[RESERVATION_DOCUMENT_NUMBER]) != NULL;
+    }
+    if (!found) PARSE_STATS_FIELD_REJECT(RESERVATION_DOCUMENT_NUMBER, FIELD_UNRESOLVED);
+    return found;
+}
+
+// Flight references, each resolved exactly once. Returns the number of
+// flights, 0 if the list is invalid or a flight does not exist.
+static size_t resolve_flights(const ParsedRow* row, Database* db, Flight* flights[RESERVATION_MAX_FLIGHTS]) {
+    const BulkRefs* bulk = row->context;
+    if (bulk && row->index < bulk->row_count) {
+        size_t count = bulk->flight_counts[row->index];
+        if (count == 0) return PARSE_REJECT("invalid flight list");
+        for (size_t k = 0; k < count; k++) {
+            flights[k] = bulk->resolved[row->index * SLOTS_PER_ROW + 1 + k];
+            if (!flights[k]) return PARSE_REJECT("unknown flight");
         }
-        
-        // Parse booleans
-        bool extra_luggage = extra_luggage_str && 
-                            (strcmp(extra_luggage_str, "true") == 0 || 
-                             strcmp(extra_luggage_str, "1") == 0);
-        bool priority_boarding = priority_boarding_str && 
-                                (strcmp(priority_boarding_str, "true") == 0 || 
-                                 strcmp(priority_boarding_str, "1") == 0);
-        
-        // Create reservation
-        Reservation* reservation = reservation_create(
-            id, (const char**)flight_ids, document_number,
+        return count;
+    }
+    
+    char* flight_ids[RESERVATION_MAX_FLIGHTS];
+    size_t count = split_flight_list(row->fields[RESERVATION_FLIGHT_IDS], flight_ids);
+    if (count == 0) return PARSE_REJECT("invalid flight list");
+    for (size_t k = 0; k < count; k++) {
+        if (!validate_flight_id_padded(flight_ids[k])) return PARSE_REJECT("unknown flight");
+        flights[k] = database_get_flight(db, flight_ids[k]);
+        if (!flights[k]) return PARSE_REJECT("unknown flight");
+    }
+    return count;
+}
+
+static bool load_reservation(const ParsedRow* row, Database* db) {
+    char** fields = row->fields;
+    
+    PARSE_STATS_LAP(STAGE_VALIDATE);
+    if (!passenger_exists(row, db)) return false;
+    
+    Flight* flights[RESERVATION_MAX_FLIGHTS] = {NULL, NULL};
+    size_t flight_count = resolve_flights(row, db, flights);
+    PARSE_STATS_LAP(STAGE_LOOKUP);
+    if (flight_count == 0) return false;
+    
+    // If 2 flights: validate connection (destination of first == origin of second)
+    if (flight_count == 2 &&
+        strcmp(flight_get_destination(flights[0]), flight_get_origin(flights[1])) != 0) {
+        return PARSE_REJECT("connection mismatch");
+    }
+    
+    // Parse price
+    double price = atof(fields[RESERVATION_PRICE]);
+    if (price < 0) return PARSE_REJECT("negative price");
+    
+    // Parse booleans
+    char* extra_luggage_str = fields[RESERVATION_EXTRA_LUGGAGE];
+    char* priority_boarding_str = fields[RESERVATION_PRIORITY_BOARDING];
+    bool extra_luggage = extra_luggage_str && 
+                        (strcmp(extra_luggage_str, "true") == 0 || 
+                         strcmp(extra_luggage_str, "1") == 0);
+    bool priority_boarding = priority_boarding_str && 
+                            (strcmp(priority_boarding_str, "true") == 0 || 
+                             strcmp(priority_boarding_str, "1") == 0);
+    PARSE_STATS_LAP(STAGE_VALIDATE);
+    
+    // Create reservation (only the ID, for duplicate detection, in validation-only mode)
+    Reservation* reservation;
+    if (database_is_keys_only(db)) {
+        reservation = reservation_create(fields[RESERVATION_ID], flights, NULL, NULL, price,
+                                         extra_luggage, priority_boarding, NULL, flight_count);
+    } else {
+        char* seat = fields[RESERVATION_SEAT];
+        char* qr_code = fields[RESERVATION_QR_CODE];
+        reservation = reservation_create(
+            fields[RESERVATION_ID], flights, fields[RESERVATION_DOCUMENT_NUMBER],
             seat ? seat : "", price, extra_luggage, priority_boarding,
             qr_code ? qr_code : "", flight_count
         );
-        
-        if (reservation) {
-            if (database_add_reservation(db, reservation) == 0) {
-                valid_count++;
-            } else {
-                // Duplicate ID
-                if (error_log) fprintf(error_log, "%s\n", original_line);
-                reservation_destroy(reservation);
-                error_count++;
-            }
-        } else {
-            if (error_log) fprintf(error_log, "%s\n", original_line);
-            error_count++;
-        }
     }
+    if (!reservation) return PARSE_REJECT("out of memory");
+    PARSE_STATS_LAP(STAGE_CREATE);
     
-    fclose(fp);
-    printf("Reservations: %d valid, %d errors\n", valid_count, error_count);
-    return 0;
+    int added = database_add_reservation(db, reservation);
+    PARSE_STATS_LAP(STAGE_INSERT);
+    if (added != 0) {
+        // Duplicate ID
+        reservation_destroy(reservation);
+        return PARSE_REJECT("duplicate id");
+    }
+    return true;
+}
+
+const TableSchema RESERVATIONS_SCHEMA = {
+    "Reservations", RESERVATION_FIELD_COUNT, RESERVATION_FIELDS, load_reservation,
+    build_bulk_refs, release_bulk_refs
+};
+
+int parse_reservations(const char* filepath, Database* db, FILE* error_log) {
+    return parse_table(filepath, &RESERVATIONS_SCHEMA, db, error_log);
 }
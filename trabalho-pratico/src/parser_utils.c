@@ -1,8 +1,11 @@
 #include "../include/parser_utils.h"
+#include <pthread.h>
 #include <string.h>
-#include <ctype.h>
 #include <stdio.h>
 #include <stdlib.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 // Parse a CSV line with quoted fields separated by commas
 // Returns number of fields parsed, or -1 on error
@@ -61,18 +64,136 @@ int parse_csv_line(char* line, char** fields, int max_fields) {
     return field_count;
 }
 
+// Character classes (256-entry table, C-locale semantics, no locale lookups)
+#define CC_DIGIT 0x01
+#define CC_UPPER 0x02
+#define CC_LOWER 0x04
+#define CC_SPACE 0x08
+#define CC_DOT   0x10
+
+#define D_ CC_DIGIT
+#define U_ CC_UPPER
+#define L_ CC_LOWER
+#define S_ CC_SPACE
+#define P_ CC_DOT
+
+static const unsigned char char_class[256] = {
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  S_, S_, S_, S_, S_, 0,  0,
+    0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    S_, 0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  P_, 0,
+    D_, D_, D_, D_, D_, D_, D_, D_, D_, D_, 0,  0,  0,  0,  0,  0,
+    0,  U_, U_, U_, U_, U_, U_, U_, U_, U_, U_, U_, U_, U_, U_, U_,
+    U_, U_, U_, U_, U_, U_, U_, U_, U_, U_, U_, 0,  0,  0,  0,  0,
+    0,  L_, L_, L_, L_, L_, L_, L_, L_, L_, L_, L_, L_, L_, L_, L_,
+    L_, L_, L_, L_, L_, L_, L_, L_, L_, L_, L_, 0,  0,  0,  0,  0,
+    /* 0x80-0xFF: no class */
+};
+
+#undef D_
+#undef U_
+#undef L_
+#undef S_
+#undef P_
+
+#define CHAR_CLASS(c) (char_class[(unsigned char)(c)])
+
+// Fixed-width pattern: every position before `len` must be a digit, an
+// uppercase letter or a given literal, and s[len] must be the terminator.
+typedef struct {
+    unsigned char literal[16];     // expected bytes where literal_mask is set
+    unsigned short digit_mask;     // bit i set => s[i] is [0-9]
+    unsigned short upper_mask;     // bit i set => s[i] is [A-Z]
+    unsigned short literal_mask;   // bit i set => s[i] == literal[i]
+    unsigned len;                  // exact string length (<= 16)
+} FixedPattern;
+
+// 2 letters + 5 digits
+static const FixedPattern FLIGHT_ID_PATTERN = {
+    {0}, 0x007C, 0x0003, 0x0000, 7
+};
+
+// 'R' + 9 digits
+static const FixedPattern RESERVATION_ID_PATTERN = {
+    {'R'}, 0x03FE, 0x0000, 0x0001, 10
+};
+
+// 9 digits
+static const FixedPattern DOCUMENT_NUMBER_PATTERN = {
+    {0}, 0x01FF, 0x0000, 0x0000, 9
+};
+
+// aaaa-mm-dd
+static const FixedPattern DATE_PATTERN = {
+    {0, 0, 0, 0, '-', 0, 0, '-'}, 0x036F, 0x0000, 0x0090, 10
+};
+
+// aaaa-mm-dd hh:mm
+static const FixedPattern DATETIME_PATTERN = {
+    {0, 0, 0, 0, '-', 0, 0, '-', 0, 0, ' ', 0, 0, ':'}, 0xDB6F, 0x0000, 0x2490, 16
+};
+
+// Scalar fallback: stops at the first mismatch, so it never reads past the
+// terminator of a shorter string.
+static bool match_fixed_scalar(const char* s, const FixedPattern* p) {
+    for (unsigned i = 0; i < p->len; i++) {
+        unsigned bit = 1u << i;
+        unsigned char cls = CHAR_CLASS(s[i]);
+        if ((p->digit_mask & bit) && !(cls & CC_DIGIT)) return false;
+        if ((p->upper_mask & bit) && !(cls & CC_UPPER)) return false;
+        if ((p->literal_mask & bit) && (unsigned char)s[i] != p->literal[i]) return false;
+    }
+    return s[p->len] == '\0';
+}
+
+// `padded`: the caller guarantees FIELD_PADDING readable bytes past the
+// terminator of `s`, so all 16 bytes can be compared at once. Any other
+// string may end right at its allocation and takes the scalar path.
+static bool match_fixed(const char* s, const FixedPattern* p, bool padded) {
+#if defined(__SSE2__)
+    if (padded) {
+        __m128i v = _mm_loadu_si128((const __m128i*)s);
+        __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)),
+                                      _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+        __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)),
+                                      _mm_cmplt_epi8(v, _mm_set1_epi8('Z' + 1)));
+        __m128i literal = _mm_cmpeq_epi8(v, _mm_loadu_si128((const __m128i*)p->literal));
+        __m128i nul = _mm_cmpeq_epi8(v, _mm_setzero_si128());
+
+        unsigned d = (unsigned)_mm_movemask_epi8(digit);
+        unsigned u = (unsigned)_mm_movemask_epi8(upper);
+        unsigned l = (unsigned)_mm_movemask_epi8(literal);
+        unsigned z = (unsigned)_mm_movemask_epi8(nul);
+
+        bool ok = ((d & p->digit_mask) == p->digit_mask) &
+                  ((u & p->upper_mask) == p->upper_mask) &
+                  ((l & p->literal_mask) == p->literal_mask);
+        if (!ok) return false;
+        // All `len` leading bytes are non-NUL here, so s[16] is readable
+        return p->len < 16 ? ((z >> p->len) & 1u) != 0 : s[16] == '\0';
+    }
+#else
+    (void)padded;
+#endif
+    return match_fixed_scalar(s, p);
+}
+
+// Two ASCII digits at s[0..1] (already validated)
+static inline int two_digits(const char* s) {
+    return (s[0] - '0') * 10 + (s[1] - '0');
+}
+
 // Trim leading and trailing whitespace
 char* trim_whitespace(char* str) {
     if (!str) return NULL;
     
     // Trim leading
-    while (isspace((unsigned char)*str)) str++;
+    while (CHAR_CLASS(*str) & CC_SPACE) str++;
     
     if (*str == 0) return str;
     
     // Trim trailing
     char* end = str + strlen(str) - 1;
-    while (end > str && isspace((unsigned char)*end)) end--;
+    while (end > str && (CHAR_CLASS(*end) & CC_SPACE)) end--;
     end[1] = '\0';
     
     return str;
@@ -80,16 +201,17 @@ char* trim_whitespace(char* str) {
 
 // Check if field is empty
 bool is_empty_field(const char* field) {
-    return !field || strlen(field) == 0;
+    return !field || field[0] == '\0';
 }
 
 // Validate IATA airport code (3 uppercase letters)
 bool validate_airport_code(const char* code) {
-    if (!code || strlen(code) != 3) return false;
-    for (int i = 0; i < 3; i++) {
-        if (!isupper((unsigned char)code[i])) return false;
-    }
-    return true;
+    if (!code) return false;
+    // Short-circuit keeps reads within the string
+    return (CHAR_CLASS(code[0]) & CC_UPPER) &&
+           (CHAR_CLASS(code[1]) & CC_UPPER) &&
+           (CHAR_CLASS(code[2]) & CC_UPPER) &&
+           code[3] == '\0';
 }
 
 // Validate latitude (-90 to 90)
@@ -110,147 +232,169 @@ bool validate_longitude(const char* lon_str) {
     return lon >= -180.0 && lon <= 180.0;
 }
 
+// Classify airport type: the first two characters select the only possible
+// candidate, so at most one strcmp is needed
+AirportType classify_airport_type(const char* type) {
+    if (!type) return AIRPORT_TYPE_INVALID;
+    switch (type[0]) {
+        case 's':
+            if (type[1] == 'm') return strcmp(type, "small_airport") == 0 ? AIRPORT_TYPE_SMALL : AIRPORT_TYPE_INVALID;
+            if (type[1] == 'e') return strcmp(type, "seaplane_base") == 0 ? AIRPORT_TYPE_SEAPLANE_BASE : AIRPORT_TYPE_INVALID;
+            return AIRPORT_TYPE_INVALID;
+        case 'm':
+            return strcmp(type, "medium_airport") == 0 ? AIRPORT_TYPE_MEDIUM : AIRPORT_TYPE_INVALID;
+        case 'l':
+            return strcmp(type, "large_airport") == 0 ? AIRPORT_TYPE_LARGE : AIRPORT_TYPE_INVALID;
+        case 'h':
+            return strcmp(type, "heliport") == 0 ? AIRPORT_TYPE_HELIPORT : AIRPORT_TYPE_INVALID;
+        default:
+            return AIRPORT_TYPE_INVALID;
+    }
+}
+
 // Validate airport type
 bool validate_airport_type(const char* type) {
-    if (!type) return false;
-    return strcmp(type, "small_airport") == 0 ||
-           strcmp(type, "medium_airport") == 0 ||
-           strcmp(type, "large_airport") == 0 ||
-           strcmp(type, "heliport") == 0 ||
-           strcmp(type, "seaplane_base") == 0;
+    return classify_airport_type(type) != AIRPORT_TYPE_INVALID;
 }
 
-// Validate email format (username@domain.tld)
+// Classify flight status (On Time, Delayed or Cancelled)
+FlightStatus classify_flight_status(const char* status) {
+    if (!status) return FLIGHT_STATUS_OTHER;
+    switch (status[0]) {
+        case 'O':
+            return strcmp(status, "On Time") == 0 ? FLIGHT_STATUS_ON_TIME : FLIGHT_STATUS_OTHER;
+        case 'D':
+            return strcmp(status, "Delayed") == 0 ? FLIGHT_STATUS_DELAYED : FLIGHT_STATUS_OTHER;
+        case 'C':
+            return strcmp(status, "Cancelled") == 0 ? FLIGHT_STATUS_CANCELLED : FLIGHT_STATUS_OTHER;
+        default:
+            return FLIGHT_STATUS_OTHER;
+    }
+}
+
+// Validate email format (username@domain.tld) in a single pass
 bool validate_email(const char* email) {
     if (!email) return false;
     
-    const char* at = strchr(email, '@');
-    if (!at || at == email) return false;
-    
-    const char* dot = strchr(at, '.');
-    if (!dot || dot == at + 1 || dot[1] == '\0') return false;
+    // Username part [a-z0-9.], non-empty
+    const char* p = email;
+    while (CHAR_CLASS(*p) & (CC_LOWER | CC_DIGIT | CC_DOT)) p++;
+    if (*p != '@' || p == email) return false;
     
-    // Check that rstring (after last dot) is 2-3 characters
-    const char* last_dot = strrchr(at, '.');
-    size_t rstring_len = strlen(last_dot + 1);
-    if (rstring_len < 2 || rstring_len > 3) return false;
+    const char* at = p++;
+    const char* first_dot = NULL;
+    const char* last_dot = NULL;
     
-    // Check username part [a-z0-9.]
-    for (const char* p = email; p < at; p++) {
-        if (!islower((unsigned char)*p) && !isdigit((unsigned char)*p) && *p != '.') {
+    // Domain part [a-z.] only (no digits in spec)
+    for (; *p; p++) {
+        unsigned char cls = CHAR_CLASS(*p);
+        if (cls & CC_DOT) {
+            if (!first_dot) first_dot = p;
+            last_dot = p;
+        } else if (!(cls & CC_LOWER)) {
             return false;
         }
     }
     
-    // Check domain part [a-z] only (no digits in spec)
-    for (const char* p = at + 1; *p; p++) {
-        if (!islower((unsigned char)*p) && *p != '.') {
-            return false;
-        }
-    }
+    if (!first_dot || first_dot == at + 1) return false;
     
-    return true;
+    // rstring (after last dot) must be 2-3 characters
+    size_t rstring_len = (size_t)(p - last_dot - 1);
+    return rstring_len >= 2 && rstring_len <= 3;
 }
 
 // Validate gender (M, F, or O)
 bool validate_gender(const char* gender_str) {
-    if (!gender_str || strlen(gender_str) != 1) return false;
-    char g = gender_str[0];
-    return g == 'M' || g == 'F' || g == 'O';
+    if (!gender_str) return false;
+    switch (gender_str[0]) {
+        case 'M': case 'F': case 'O':
+            return gender_str[1] == '\0';
+        default:
+            return false;
+    }
 }
 
 // Validate flight ID (2 letters + 5 digits, e.g., KS07323) - strict as per spec
 bool validate_flight_id(const char* id) {
-    if (!id || strlen(id) != 7) return false;
-    if (!isupper((unsigned char)id[0]) || !isupper((unsigned char)id[1])) return false;
-    for (int i = 2; i < 7; i++) {
-        if (!isdigit((unsigned char)id[i])) return false;
-    }
-    return true;
+    return id && match_fixed(id, &FLIGHT_ID_PATTERN, false);
+}
+
+bool validate_flight_id_padded(const char* id) {
+    return id && match_fixed(id, &FLIGHT_ID_PATTERN, true);
 }
 
 // Validate reservation ID (R + 9 digits)
 bool validate_reservation_id(const char* id) {
-    if (!id || strlen(id) != 10) return false;
-    if (id[0] != 'R') return false;
-    for (int i = 1; i < 10; i++) {
-        if (!isdigit((unsigned char)id[i])) return false;
-    }
-    return true;
+    return id && match_fixed(id, &RESERVATION_ID_PATTERN, false);
+}
+
+bool validate_reservation_id_padded(const char* id) {
+    return id && match_fixed(id, &RESERVATION_ID_PATTERN, true);
 }
 
 // Validate document number (9 digits)
 bool validate_document_number(const char* doc) {
-    if (!doc || strlen(doc) != 9) return false;
-    for (int i = 0; i < 9; i++) {
-        if (!isdigit((unsigned char)doc[i])) return false;
+    return doc && match_fixed(doc, &DOCUMENT_NUMBER_PATTERN, false);
+}
+
+bool validate_document_number_padded(const char* doc) {
+    return doc && match_fixed(doc, &DOCUMENT_NUMBER_PATTERN, true);
+}
+
+// Today's date as yyyymmdd, recomputed once the local day is over (a live
+// run lasts for days; tables may be loaded by several threads at once)
+static int today = 0;
+static time_t today_ends = 0;          // first second of tomorrow
+static pthread_mutex_t today_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static int today_yyyymmdd(void) {
+    time_t now = time(NULL);
+    if (now >= __atomic_load_n(&today_ends, __ATOMIC_ACQUIRE)) {
+        pthread_mutex_lock(&today_mutex);
+        if (now >= today_ends) {
+            struct tm current;
+            localtime_r(&now, &current);
+            __atomic_store_n(&today, (current.tm_year + 1900) * 10000 + (current.tm_mon + 1) * 100 +
+                                     current.tm_mday, __ATOMIC_RELAXED);
+            struct tm midnight = { .tm_year = current.tm_year, .tm_mon = current.tm_mon,
+                                   .tm_mday = current.tm_mday + 1, .tm_isdst = -1 };
+            time_t ends = mktime(&midnight);
+            __atomic_store_n(&today_ends, ends > now ? ends : now + 1, __ATOMIC_RELEASE);
+        }
+        pthread_mutex_unlock(&today_mutex);
     }
-    return true;
+    return __atomic_load_n(&today, __ATOMIC_RELAXED);
 }
 
 // Validate date format (aaaa-mm-dd) - STRICT: only hyphens, no future dates
-bool validate_date(const char* date_str) {
-    if (!date_str || strlen(date_str) != 10) return false;
-    
-    // Must use hyphens, not slashes
-    if (date_str[4] != '-' || date_str[7] != '-') {
-        return false;
-    }
+static bool check_date(const char* date_str, bool padded) {
+    if (!date_str || !match_fixed(date_str, &DATE_PATTERN, padded)) return false;
     
-    // Check all other characters are digits
-    for (int i = 0; i < 10; i++) {
-        if (i == 4 || i == 7) continue;
-        if (!isdigit((unsigned char)date_str[i])) return false;
-    }
-    
-    int year, month, day;
-    if (sscanf(date_str, "%d-%d-%d", &year, &month, &day) != 3) {
-        return false;
-    }
+    int year = two_digits(date_str) * 100 + two_digits(date_str + 2);
+    int month = two_digits(date_str + 5);
+    int day = two_digits(date_str + 8);
     
     if (month < 1 || month > 12) return false;
     if (day < 1 || day > 31) return false;
     
     // Check date is not in the future
-    time_t now = time(NULL);
-    struct tm* current = localtime(&now);
-    int current_year = current->tm_year + 1900;
-    int current_month = current->tm_mon + 1;
-    int current_day = current->tm_mday;
-    
-    if (year > current_year) return false;
-    if (year == current_year && month > current_month) return false;
-    if (year == current_year && month == current_month && day > current_day) return false;
-    
-    return true;
+    return year * 10000 + month * 100 + day <= today_yyyymmdd();
 }
 
 // Validate datetime format (aaaa-mm-dd hh:mm) - STRICT: only hyphens allowed
-bool validate_datetime(const char* datetime_str) {
-    if (!datetime_str || strlen(datetime_str) != 16) return false;
-    
-    // Check format strictly: aaaa-mm-dd hh:mm (only hyphens allowed)
-    if (datetime_str[4] != '-' || datetime_str[7] != '-' || 
-        datetime_str[10] != ' ' || datetime_str[13] != ':') {
-        return false;
-    }
+static bool check_datetime(const char* datetime_str, bool padded) {
+    if (!datetime_str || !match_fixed(datetime_str, &DATETIME_PATTERN, padded)) return false;
     
-    // Check all digit positions
-    for (int i = 0; i < 16; i++) {
-        if (i == 4 || i == 7 || i == 10 || i == 13) continue;
-        if (!isdigit((unsigned char)datetime_str[i])) return false;
-    }
-    
-    int year, month, day, hour, minute;
-    if (sscanf(datetime_str, "%d-%d-%d %d:%d", 
-               &year, &month, &day, &hour, &minute) != 5) {
-        return false;
-    }
+    int year = two_digits(datetime_str) * 100 + two_digits(datetime_str + 2);
+    int month = two_digits(datetime_str + 5);
+    int day = two_digits(datetime_str + 8);
+    int hour = two_digits(datetime_str + 11);
+    int minute = two_digits(datetime_str + 14);
     
     if (month < 1 || month > 12) return false;
     if (day < 1 || day > 31) return false;
-    if (hour < 0 || hour > 23) return false;
-    if (minute < 0 || minute > 59) return false;
+    if (hour > 23) return false;
+    if (minute > 59) return false;
     
     // For flights, we don't reject future dates as flights are scheduled in advance
     // Only reject dates that are clearly invalid (e.g., year < 1900 or > 2100)
@@ -259,6 +403,22 @@ bool validate_datetime(const char* datetime_str) {
     return true;
 }
 
+bool validate_date(const char* date_str) {
+    return check_date(date_str, false);
+}
+
+bool validate_date_padded(const char* date_str) {
+    return check_date(date_str, true);
+}
+
+bool validate_datetime(const char* datetime_str) {
+    return check_datetime(datetime_str, false);
+}
+
+bool validate_datetime_padded(const char* datetime_str) {
+    return check_datetime(datetime_str, true);
+}
+
 // Parse date string to time_t
 time_t parse_date(const char* date_str) {
     struct tm tm = {0};
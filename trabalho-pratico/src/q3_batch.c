@@ -0,0 +1,123 @@
+#include "../include/q3_batch.h"
+#include "../include/airports.h"
+#include "../include/departure_index.h"
+#include "../include/flights.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    time_t when;
+    size_t airport;            // position in the code-sorted airports
+} Departure;
+
+typedef struct {
+    time_t before;             // counts are taken over departures earlier than this
+    size_t range;
+    bool upper;                // end of the range (else its start)
+} Endpoint;
+
+static int compare_departures(const void* a, const void* b) {
+    time_t ta = ((const Departure*)a)->when;
+    time_t tb = ((const Departure*)b)->when;
+    return (ta > tb) - (ta < tb);
+}
+
+// Starts before ends at the same instant, so an empty range sees no departures
+static int compare_endpoints(const void* a, const void* b) {
+    const Endpoint* ea = a;
+    const Endpoint* eb = b;
+    if (ea->before != eb->before) return (ea->before > eb->before) - (ea->before < eb->before);
+    return (int)ea->upper - (int)eb->upper;
+}
+
+// Departures Q3 counts, at their effective time, sorted by time
+static Departure* collect_departures(Database* db, Airport** airports, size_t airport_count, size_t* count) {
+    size_t flight_count;
+    Flight** flights = database_get_all_flights(db, &flight_count);
+    Departure* departures = malloc((flight_count ? flight_count : 1) * sizeof(Departure));
+    if (!departures || (flight_count > 0 && !flights)) {
+        free(flights);
+        free(departures);
+        return NULL;
+    }
+    
+    *count = 0;
+    for (size_t i = 0; i < flight_count; i++) {
+        time_t when;
+        if (!departure_index_effective_departure(flights[i], &when)) continue;
+        
+        size_t airport = departure_index_find_airport(airports, airport_count, flight_get_origin(flights[i]));
+        if (airport == airport_count) continue;
+        departures[(*count)++] = (Departure){ when, airport };
+    }
+    free(flights);
+    
+    qsort(departures, *count, sizeof(Departure), compare_departures);
+    return departures;
+}
+
+bool q3_batch_evaluate(Database* db, Q3Range* ranges, size_t count) {
+    if (!db || (!ranges && count > 0)) return false;
+    for (size_t r = 0; r < count; r++) {
+        ranges[r].airport = NULL;
+        ranges[r].departures = 0;
+    }
+    if (count == 0) return true;
+    
+    size_t airport_count;
+    Airport** airports = departure_index_sorted_airports(db, &airport_count);
+    if (airport_count == 0) return true;    // every answer is "no airport"
+    if (!airports) return false;
+    
+    size_t departure_count = 0;
+    Departure* departures = collect_departures(db, airports, airport_count, &departure_count);
+    Endpoint* endpoints = malloc(2 * count * sizeof(Endpoint));
+    size_t* running = calloc(airport_count, sizeof(size_t));
+    size_t* at_start = malloc(count * airport_count * sizeof(size_t));   // snapshot per range start
+    if (!departures || !endpoints || !running || !at_start) {
+        free(airports);
+        free(departures);
+        free(endpoints);
+        free(running);
+        free(at_start);
+        return false;
+    }
+    
+    for (size_t r = 0; r < count; r++) {
+        endpoints[2 * r] = (Endpoint){ ranges[r].from, r, false };
+        endpoints[2 * r + 1] = (Endpoint){ ranges[r].to + 1, r, true };
+    }
+    qsort(endpoints, 2 * count, sizeof(Endpoint), compare_endpoints);
+    
+    // One sweep: advance the running counts to each endpoint in turn
+    size_t next = 0;
+    for (size_t e = 0; e < 2 * count; e++) {
+        const Endpoint* endpoint = &endpoints[e];
+        while (next < departure_count && departures[next].when < endpoint->before) {
+            running[departures[next++].airport]++;
+        }
+        
+        size_t* start = &at_start[endpoint->range * airport_count];
+        if (!endpoint->upper) {
+            memcpy(start, running, airport_count * sizeof(size_t));
+            continue;
+        }
+        
+        Q3Range* range = &ranges[endpoint->range];
+        range->airport = airports[0];
+        for (size_t a = 0; a < airport_count; a++) {
+            size_t in_range = running[a] - start[a];
+            if (in_range > range->departures) {
+                range->departures = in_range;
+                range->airport = airports[a];
+            }
+        }
+    }
+    
+    free(airports);
+    free(departures);
+    free(endpoints);
+    free(running);
+    free(at_start);
+    return true;
+}
@@ -0,0 +1,159 @@
+#include "../include/query_cache.h"
+#include "../include/scratch_arena.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define MIN_BUCKETS 256                // power of two
+#define BYTES_PER_BUCKET 64
+
+typedef struct cache_entry {
+    struct cache_entry* next;      // next entry in the bucket
+    uint64_t version;
+    size_t length;                 // output bytes
+    char* output;                  // follows the key
+    char key[];
+} CacheEntry;
+
+typedef struct query_cache {
+    CacheEntry** buckets;
+    size_t bucket_count;
+    size_t entry_count;
+    ScratchArena* storage;         // entries, in one block of max_bytes released all at once
+    size_t max_bytes;
+    QueryCacheStats stats;
+} QueryCache;
+
+// Hash function (djb2 algorithm), as for the database tables
+static unsigned long hash_string(const char* str) {
+    unsigned long hash = 5381UL;
+    int c;
+    while ((c = *str++)) {
+        hash = ((hash << 5) + hash) + (unsigned char)c; // hash * 33 + c
+    }
+    return hash;
+}
+
+QueryCache* query_cache_create(size_t max_bytes) {
+    QueryCache* cache = calloc(1, sizeof(QueryCache));
+    if (!cache) return NULL;
+
+    // Storage and buckets are allocated for a full cache up front (the
+    // pages are only touched as entries arrive), so storing an entry does
+    // not reach the heap
+    size_t bucket_count = MIN_BUCKETS;
+    while (bucket_count < max_bytes / BYTES_PER_BUCKET) bucket_count *= 2;
+    cache->buckets = calloc(bucket_count, sizeof(CacheEntry*));
+    cache->storage = scratch_arena_create(max_bytes);
+    if (!cache->buckets || !cache->storage) {
+        free(cache->buckets);
+        scratch_arena_destroy(cache->storage);
+        free(cache);
+        return NULL;
+    }
+    cache->bucket_count = bucket_count;
+    cache->max_bytes = max_bytes;
+    return cache;
+}
+
+static void clear_entries(QueryCache* cache) {
+    memset(cache->buckets, 0, cache->bucket_count * sizeof(CacheEntry*));
+    scratch_reset(cache->storage);
+    cache->entry_count = 0;
+}
+
+void query_cache_destroy(QueryCache* cache) {
+    if (!cache) return;
+    scratch_arena_destroy(cache->storage);
+    free(cache->buckets);
+    free(cache);
+}
+
+// Link to the entry of `key` (or to the NULL ending its bucket)
+static CacheEntry** find(QueryCache* cache, const char* key) {
+    CacheEntry** link = &cache->buckets[hash_string(key) & (cache->bucket_count - 1)];
+    while (*link && strcmp((*link)->key, key) != 0) link = &(*link)->next;
+    return link;
+}
+
+// Its storage is only reclaimed when the cache is emptied
+static void unlink_entry(QueryCache* cache, CacheEntry** link) {
+    *link = (*link)->next;
+    cache->entry_count--;
+}
+
+// Doubles the buckets once entries outnumber them. On allocation failure
+// the cache keeps its current buckets (longer chains, still correct).
+static void grow(QueryCache* cache) {
+    size_t bucket_count = cache->bucket_count * 2;
+    CacheEntry** buckets = calloc(bucket_count, sizeof(CacheEntry*));
+    if (!buckets) return;
+
+    for (size_t b = 0; b < cache->bucket_count; b++) {
+        CacheEntry* entry = cache->buckets[b];
+        while (entry) {
+            CacheEntry* next = entry->next;
+            size_t index = hash_string(entry->key) & (bucket_count - 1);
+            entry->next = buckets[index];
+            buckets[index] = entry;
+            entry = next;
+        }
+    }
+
+    free(cache->buckets);
+    cache->buckets = buckets;
+    cache->bucket_count = bucket_count;
+}
+
+bool query_cache_get(QueryCache* cache, const char* key, uint64_t version,
+                     const char** output, size_t* length) {
+    if (!cache || !key) return false;
+    cache->stats.lookups++;
+
+    CacheEntry** link = find(cache, key);
+    if (!*link) return false;
+    if ((*link)->version != version) {
+        unlink_entry(cache, link);
+        cache->stats.invalidations++;
+        return false;
+    }
+
+    cache->stats.hits++;
+    *output = (*link)->output;
+    *length = (*link)->length;
+    return true;
+}
+
+void query_cache_put(QueryCache* cache, const char* key, uint64_t version,
+                     const char* output, size_t length) {
+    if (!cache || !key || (!output && length > 0)) return;
+
+    size_t key_size = strlen(key) + 1;
+    size_t size = sizeof(CacheEntry) + key_size + length;
+    if (size > cache->max_bytes) return;
+
+    CacheEntry** link = find(cache, key);
+    if (*link) unlink_entry(cache, link);
+
+    if (!scratch_fits(cache->storage, size)) clear_entries(cache);
+
+    CacheEntry* entry = scratch_alloc(cache->storage, size);
+    if (!entry) return;
+    memcpy(entry->key, key, key_size);
+    entry->output = entry->key + key_size;
+    if (length > 0) memcpy(entry->output, output, length);
+    entry->length = length;
+    entry->version = version;
+
+    // The bucket may have been emptied above
+    link = &cache->buckets[hash_string(key) & (cache->bucket_count - 1)];
+    entry->next = *link;
+    *link = entry;
+    cache->entry_count++;
+
+    if (cache->entry_count > cache->bucket_count) grow(cache);
+}
+
+QueryCacheStats query_cache_stats(const QueryCache* cache) {
+    QueryCacheStats none = { 0 };
+    return cache ? cache->stats : none;
+}
@@ -0,0 +1,197 @@
+#include "../include/query_plan.h"
+#include "../include/parser_utils.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_QUERY_LINE 256
+
+typedef struct query_plan {
+    char* text;                    // every line read, each NUL-terminated
+    CompiledQuery* queries;
+    size_t count;
+} QueryPlan;
+
+// Splits a query line (copied into `line`) into its number and arguments
+static bool split_query(const char* query_line, char line[MAX_QUERY_LINE], int* query_num, char** arg) {
+    strncpy(line, query_line, MAX_QUERY_LINE - 1);
+    line[MAX_QUERY_LINE - 1] = '\0';
+    line[strcspn(line, "\n")] = 0;
+
+    // Parse query number and arguments
+    char* query_num_str = strtok(line, " ");
+    *arg = strtok(NULL, "");
+
+    if (!query_num_str) return false;
+
+    *query_num = atoi(query_num_str);
+    return true;
+}
+
+// Q2 arguments: N and an optional manufacturer
+static void parse_q2_args(const char* arg, int* n, char manufacturer[128]) {
+    if (strchr(arg, ' ')) {
+        sscanf(arg, "%d %127s", n, manufacturer);
+    } else {
+        *n = atoi(arg);
+    }
+}
+
+// Q3 arguments: two dates in either order, as the range from the first
+// midnight to the last second of the later day. False if invalid.
+static bool parse_q3_range(const char* arg, time_t* from, time_t* to) {
+    char date1_str[11], date2_str[11];
+    if (sscanf(arg, "%10s %10s", date1_str, date2_str) != 2) return false;
+
+    char date1_dt[17]; // "YYYY-MM-DD hh:mm"
+    char date2_dt[17];
+    snprintf(date1_dt, sizeof(date1_dt), "%s 00:00", date1_str);
+    snprintf(date2_dt, sizeof(date2_dt), "%s 00:00", date2_str);
+
+    if (!validate_datetime(date1_dt) || !validate_datetime(date2_dt)) return false;
+
+    time_t date1 = parse_date(date1_str);
+    time_t date2 = parse_date(date2_str);
+
+    // Ensure date1 <= date2
+    if (date1 > date2) {
+        time_t temp = date1;
+        date1 = date2;
+        date2 = temp;
+    }
+
+    *from = date1;
+    *to = date2 + 86399; // Make date2 end of day (23:59:59)
+    return true;
+}
+
+bool query_compile(const char* line, CompiledQuery* query) {
+    memset(query, 0, sizeof(CompiledQuery));
+    query->line = line;
+
+    char copy[MAX_QUERY_LINE];
+    char* arg;
+    if (!split_query(line, copy, &query->number, &arg)) {
+        query->empty = true;
+        return false;
+    }
+
+    switch (query->number) {
+        case 1:
+            // The code is looked up exactly as written: same offset in the line
+            if (arg) {
+                query->args.q1.code = line + (arg - copy);
+                query->args.q1.length = strlen(arg);
+            }
+            break;
+        case 2:
+            if (arg) parse_q2_args(arg, &query->args.q2.n, query->args.q2.manufacturer);
+            break;
+        case 3:
+            query->args.q3.valid = arg && parse_q3_range(arg, &query->args.q3.from, &query->args.q3.to);
+            break;
+    }
+    return true;
+}
+
+void query_canonical(const CompiledQuery* query, char* text, size_t size) {
+    switch (query->number) {
+        case 1:
+            if (query->args.q1.code) {
+                snprintf(text, size, "1 %.*s", (int)query->args.q1.length, query->args.q1.code);
+            } else {
+                snprintf(text, size, "1");
+            }
+            break;
+        case 2:
+            // Every N below 1 answers nothing
+            snprintf(text, size, "2 %d %s", query->args.q2.n > 0 ? query->args.q2.n : 0,
+                     query->args.q2.manufacturer);
+            break;
+        case 3:
+            if (query->args.q3.valid) {
+                snprintf(text, size, "3 %lld %lld", (long long)query->args.q3.from,
+                         (long long)query->args.q3.to);
+            } else {
+                snprintf(text, size, "3");
+            }
+            break;
+        default:
+            snprintf(text, size, "%d", query->number);
+            break;
+    }
+}
+
+QueryPlan* query_plan_read(FILE* input) {
+    if (!input) return NULL;
+
+    QueryPlan* plan = calloc(1, sizeof(QueryPlan));
+    if (!plan) return NULL;
+
+    // Lines are appended to one buffer first; queries point into it once
+    // it stops moving
+    size_t* offsets = NULL;
+    size_t offset_capacity = 0;
+    size_t text_length = 0;
+    size_t text_capacity = 0;
+    bool ok = true;
+
+    char line[MAX_QUERY_LINE];
+    while (ok && fgets(line, sizeof(line), input)) {
+        // Skip empty lines
+        if (line[0] == '\n' || line[0] == '\0') continue;
+
+        size_t length = strlen(line) + 1;
+        if (plan->count == offset_capacity) {
+            offset_capacity = offset_capacity ? offset_capacity * 2 : 64;
+            size_t* grown = realloc(offsets, offset_capacity * sizeof(size_t));
+            if (!grown) {
+                ok = false;
+                break;
+            }
+            offsets = grown;
+        }
+        if (text_length + length > text_capacity) {
+            text_capacity = text_capacity ? text_capacity * 2 : 4096;
+            while (text_length + length > text_capacity) text_capacity *= 2;
+            char* grown = realloc(plan->text, text_capacity);
+            if (!grown) {
+                ok = false;
+                break;
+            }
+            plan->text = grown;
+        }
+        memcpy(plan->text + text_length, line, length);
+        offsets[plan->count++] = text_length;
+        text_length += length;
+    }
+
+    if (ok && plan->count > 0) {
+        plan->queries = malloc(plan->count * sizeof(CompiledQuery));
+        ok = plan->queries != NULL;
+    }
+    for (size_t i = 0; ok && i < plan->count; i++) {
+        query_compile(plan->text + offsets[i], &plan->queries[i]);
+    }
+    free(offsets);
+
+    if (!ok) {
+        query_plan_destroy(plan);
+        return NULL;
+    }
+    return plan;
+}
+
+void query_plan_destroy(QueryPlan* plan) {
+    if (!plan) return;
+    free(plan->text);
+    free(plan->queries);
+    free(plan);
+}
+
+size_t query_plan_count(const QueryPlan* plan) {
+    return plan ? plan->count : 0;
+}
+
+const CompiledQuery* query_plan_get(const QueryPlan* plan, size_t index) {
+    return plan && index < plan->count ? &plan->queries[index] : NULL;
+}
@@ -0,0 +1,84 @@
+#include "../include/query_pool.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define QUERY_POOL_MAX_WORKERS 8
+
+typedef struct {
+    size_t count;
+    QueryPoolTask run;
+    void* context;
+    size_t next;                   // next index to hand out (atomic)
+    bool* done;                    // done[i]: query i finished (guarded by mutex)
+    pthread_mutex_t mutex;
+    pthread_cond_t finished;
+} QueryPool;
+
+int query_pool_workers(size_t count) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus < 2 || count < 2) return 0;
+
+    long workers = cpus;
+    if (workers > QUERY_POOL_MAX_WORKERS) workers = QUERY_POOL_MAX_WORKERS;
+    if ((size_t)workers > count) workers = (long)count;
+    return (int)workers;
+}
+
+static void* worker(void* arg) {
+    QueryPool* pool = arg;
+    for (;;) {
+        size_t index = __atomic_fetch_add(&pool->next, 1, __ATOMIC_RELAXED);
+        if (index >= pool->count) break;
+
+        pool->run(pool->context, index);
+
+        pthread_mutex_lock(&pool->mutex);
+        pool->done[index] = true;
+        pthread_cond_broadcast(&pool->finished);
+        pthread_mutex_unlock(&pool->mutex);
+    }
+    return NULL;
+}
+
+bool query_pool_run(size_t count, int workers, QueryPoolTask run, QueryPoolTask finished, void* context) {
+    if (!run || workers < 1) return false;
+    if (count == 0) return true;
+
+    QueryPool pool = { .count = count, .run = run, .context = context, .next = 0 };
+    pool.done = calloc(count, sizeof(bool));
+    pthread_t* threads = malloc((size_t)workers * sizeof(pthread_t));
+    if (!pool.done || !threads) {
+        free(pool.done);
+        free(threads);
+        return false;
+    }
+    pthread_mutex_init(&pool.mutex, NULL);
+    pthread_cond_init(&pool.finished, NULL);
+
+    int started = 0;
+    while (started < workers && pthread_create(&threads[started], NULL, worker, &pool) == 0) started++;
+
+    if (started == 0) {
+        pthread_mutex_destroy(&pool.mutex);
+        pthread_cond_destroy(&pool.finished);
+        free(pool.done);
+        free(threads);
+        return false;
+    }
+
+    // Fewer workers than asked for still get through every query
+    for (size_t i = 0; i < count; i++) {
+        pthread_mutex_lock(&pool.mutex);
+        while (!pool.done[i]) pthread_cond_wait(&pool.finished, &pool.mutex);
+        pthread_mutex_unlock(&pool.mutex);
+        if (finished) finished(context, i);
+    }
+
+    for (int t = 0; t < started; t++) pthread_join(threads[t], NULL);
+    pthread_mutex_destroy(&pool.mutex);
+    pthread_cond_destroy(&pool.finished);
+    free(pool.done);
+    free(threads);
+    return true;
+}
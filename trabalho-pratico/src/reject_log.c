@@ -0,0 +1,92 @@
+#include "../include/reject_log.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+// Each row takes two iovecs (the row and its line terminator)
+#define REJECT_LOG_MAX_ROWS 512
+
+typedef struct {
+    off_t offset;
+    size_t length;
+    bool had_newline;
+} RejectedRange;
+
+typedef struct reject_log {
+    int fd;
+    RejectedRange ranges[REJECT_LOG_MAX_ROWS];
+    size_t count;
+} RejectLog;
+
+RejectLog* reject_log_create(FILE* output) {
+    if (!output) return NULL;
+    
+    RejectLog* log = malloc(sizeof(RejectLog));
+    if (!log) return NULL;
+    
+    // Anything already buffered (e.g. the header) must reach the file first
+    fflush(output);
+    log->fd = fileno(output);
+    log->count = 0;
+    return log;
+}
+
+void reject_log_destroy(RejectLog* log) {
+    free(log);
+}
+
+void reject_log_record(RejectLog* log, off_t offset, size_t length, bool had_newline) {
+    if (!log || log->count == REJECT_LOG_MAX_ROWS) return;
+    
+    RejectedRange* range = &log->ranges[log->count++];
+    range->offset = offset;
+    range->length = length;
+    range->had_newline = had_newline;
+}
+
+bool reject_log_full(const RejectLog* log) {
+    return log && log->count == REJECT_LOG_MAX_ROWS;
+}
+
+// writev until everything is written (handles short writes)
+static void write_all(int fd, struct iovec* iov, int iovcnt) {
+    while (iovcnt > 0) {
+        ssize_t written = writev(fd, iov, iovcnt);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        while (iovcnt > 0 && (size_t)written >= iov->iov_len) {
+            written -= (ssize_t)iov->iov_len;
+            iov++;
+            iovcnt--;
+        }
+        if (iovcnt > 0) {
+            iov->iov_base = (char*)iov->iov_base + written;
+            iov->iov_len -= (size_t)written;
+        }
+    }
+}
+
+void reject_log_flush(RejectLog* log, const char* buffer, off_t buffer_offset) {
+    if (!log || log->count == 0) return;
+    
+    // Historical format: the original line with its newline, then another newline
+    static char terminators[] = "\n\n";
+    struct iovec iov[REJECT_LOG_MAX_ROWS * 2];
+    int iovcnt = 0;
+    
+    for (size_t i = 0; i < log->count; i++) {
+        const RejectedRange* range = &log->ranges[i];
+        iov[iovcnt].iov_base = (char*)buffer + (range->offset - buffer_offset);
+        iov[iovcnt].iov_len = range->length;
+        iovcnt++;
+        iov[iovcnt].iov_base = terminators;
+        iov[iovcnt].iov_len = range->had_newline ? 2 : 1;
+        iovcnt++;
+    }
+    
+    write_all(log->fd, iov, iovcnt);
+    log->count = 0;
+}
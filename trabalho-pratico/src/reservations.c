@@ -5,7 +5,7 @@
 
 typedef struct reservation {
     char *id;                // número da reserva
-    char **flight_ids;       // identificadores dos voos associados à reserva (lista de 1 ou 2)
+    const Flight *flights[RESERVATION_MAX_FLIGHTS]; // voos associados à reserva (lista de 1 ou 2), resolvidos no parsing
     char *document_number;   // número do documento de identificação do passageiro associado à reserva
     char *seat;              // número do lugar reservado (e.g., 12A)
     double price;            // preço da reserva
@@ -16,9 +16,9 @@ typedef struct reservation {
 } Reservation;
 
 // create
-Reservation *reservation_create(const char *id, const char **flight_ids, const char *document_number, const char *seat, double price, bool extra_luggage, bool priority_boarding, const char *qr_code, size_t flight_count) {
+Reservation *reservation_create(const char *id, Flight *const *flights, const char *document_number, const char *seat, double price, bool extra_luggage, bool priority_boarding, const char *qr_code, size_t flight_count) {
     if (!id || strlen(id) == 0) return NULL;
-    if (flight_count < 1 || flight_count > 2) return NULL; // só 1 ou 2 voos permitidos
+    if (flight_count < 1 || flight_count > RESERVATION_MAX_FLIGHTS) return NULL; // só 1 ou 2 voos permitidos
 
     Reservation *reservation = malloc(sizeof(Reservation));
     if (!reservation) return NULL;
@@ -32,10 +32,9 @@ Reservation *reservation_create(const char *id, const char **flight_ids, const c
     reservation->qr_code = qr_code ? strdup(qr_code) : NULL;
     reservation->flight_count = flight_count;
 
-    // Copiar flight_ids
-    reservation->flight_ids = malloc(flight_count * sizeof(char *));
+    // Guardar referências para os voos (pertencem à base de dados)
     for (size_t i = 0; i < flight_count; i++) {
-        reservation->flight_ids[i] = strdup(flight_ids[i]);
+        reservation->flights[i] = flights[i];
     }
 
     return reservation;
@@ -50,13 +49,6 @@ void reservation_destroy(Reservation *reservation) {
     free(reservation->seat);
     free(reservation->qr_code);
 
-    // libertar flight_ids
-    if (reservation->flight_ids) {
-        for (size_t i = 0; i < reservation->flight_count; i++)
-            free(reservation->flight_ids[i]);
-        free(reservation->flight_ids);
-    }
-
     free(reservation);
 }
 
@@ -65,7 +57,12 @@ const char *reservation_get_id(const Reservation *reservation) { return reservat
 
 const char *reservation_get_flight_id(const Reservation *reservation, size_t index) {
     if (!reservation || index >= reservation->flight_count) return NULL;
-    return reservation->flight_ids[index];
+    return flight_get_id(reservation->flights[index]);
+}
+
+const Flight *reservation_get_flight(const Reservation *reservation, size_t index) {
+    if (!reservation || index >= reservation->flight_count) return NULL;
+    return reservation->flights[index];
 }
 
 const char *reservation_get_document_number(const Reservation *reservation) { return reservation ? reservation->document_number : NULL; }
@@ -0,0 +1,175 @@
+#include "../include/scratch_arena.h"
+#include <stdarg.h>
+#include <stdalign.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ALIGNMENT alignof(max_align_t)
+#define MIN_TEXT_CAPACITY 256
+
+typedef struct chunk {
+    struct chunk* next;            // older, smaller chunk
+    size_t size;
+    size_t used;
+    alignas(max_align_t) unsigned char data[];
+} Chunk;
+
+typedef struct scratch_arena {
+    Chunk* chunks;                 // newest (and largest) first; allocations come from it
+} ScratchArena;
+
+static Chunk* chunk_create(size_t size) {
+    Chunk* chunk = malloc(sizeof(Chunk) + size);
+    if (!chunk) return NULL;
+    chunk->next = NULL;
+    chunk->size = size;
+    chunk->used = 0;
+    return chunk;
+}
+
+ScratchArena* scratch_arena_create(size_t initial_size) {
+    ScratchArena* arena = malloc(sizeof(ScratchArena));
+    if (!arena) return NULL;
+
+    arena->chunks = chunk_create(initial_size ? initial_size : 4096);
+    if (!arena->chunks) {
+        free(arena);
+        return NULL;
+    }
+    return arena;
+}
+
+void scratch_arena_destroy(ScratchArena* arena) {
+    if (!arena) return;
+    Chunk* chunk = arena->chunks;
+    while (chunk) {
+        Chunk* next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    free(arena);
+}
+
+static size_t align_up(size_t size) {
+    return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+void* scratch_alloc(ScratchArena* arena, size_t size) {
+    if (!arena) return NULL;
+    size = align_up(size ? size : 1);
+
+    Chunk* chunk = arena->chunks;
+    if (chunk->size - chunk->used < size) {
+        // Each new chunk at least doubles the arena
+        size_t grown = chunk->size * 2;
+        chunk = chunk_create(grown > size ? grown : size);
+        if (!chunk) return NULL;
+        chunk->next = arena->chunks;
+        arena->chunks = chunk;
+    }
+
+    void* memory = chunk->data + chunk->used;
+    chunk->used += size;
+    return memory;
+}
+
+bool scratch_fits(const ScratchArena* arena, size_t size) {
+    return arena && arena->chunks->size - arena->chunks->used >= align_up(size ? size : 1);
+}
+
+void scratch_reset(ScratchArena* arena) {
+    if (!arena) return;
+
+    // Several chunks: the round needed more than the first one, so they are
+    // merged for the next round (keeping the largest if that fails)
+    Chunk* newest = arena->chunks;
+    if (newest->next) {
+        size_t total = 0;
+        for (Chunk* chunk = newest; chunk; chunk = chunk->next) total += chunk->size;
+
+        Chunk* merged = chunk_create(total);
+        Chunk* chunk = merged ? newest : newest->next;
+        while (chunk) {
+            Chunk* next = chunk->next;
+            free(chunk);
+            chunk = next;
+        }
+        arena->chunks = merged ? merged : newest;
+        arena->chunks->next = NULL;
+    }
+    arena->chunks->used = 0;
+}
+
+// Grows the last allocation of the arena in place if it is `memory` and the
+// chunk has room
+static bool extend_in_place(ScratchArena* arena, void* memory, size_t old_size, size_t new_size) {
+    Chunk* chunk = arena->chunks;
+    unsigned char* end = chunk->data + chunk->used;
+    if ((unsigned char*)memory + align_up(old_size) != end) return false;
+
+    size_t extra = align_up(new_size) - align_up(old_size);
+    if (chunk->size - chunk->used < extra) return false;
+    chunk->used += extra;
+    return true;
+}
+
+void scratch_text_init(ScratchText* text, ScratchArena* arena) {
+    text->arena = arena;
+    text->data = NULL;
+    text->length = 0;
+    text->capacity = 0;
+    text->failed = false;
+}
+
+// Room for `extra` more characters and the terminator
+static bool text_reserve(ScratchText* text, size_t extra) {
+    size_t needed = text->length + extra + 1;
+    if (needed <= text->capacity) return true;
+
+    size_t capacity = text->capacity ? text->capacity * 2 : MIN_TEXT_CAPACITY;
+    if (capacity < needed) capacity = needed;
+
+    if (text->data && extend_in_place(text->arena, text->data, text->capacity, capacity)) {
+        text->capacity = capacity;
+        return true;
+    }
+    char* data = scratch_alloc(text->arena, capacity);
+    if (!data) return false;
+    if (text->data) memcpy(data, text->data, text->length + 1);
+    text->data = data;
+    text->capacity = capacity;
+    return true;
+}
+
+void scratch_text_printf(ScratchText* text, const char* format, ...) {
+    if (text->failed) return;
+    if (!text->data && !text_reserve(text, 0)) {
+        text->failed = true;
+        return;
+    }
+
+    va_list args;
+    va_start(args, format);
+    va_list retry;
+    va_copy(retry, args);
+
+    size_t room = text->capacity - text->length;
+    int written = vsnprintf(text->data + text->length, room, format, args);
+    if (written >= 0 && (size_t)written >= room) {
+        if (text_reserve(text, (size_t)written)) {
+            vsnprintf(text->data + text->length, text->capacity - text->length, format, retry);
+        } else {
+            text->data[text->length] = '\0';
+            written = -1;
+        }
+    }
+    va_end(retry);
+    va_end(args);
+
+    if (written < 0) {
+        text->failed = true;
+        return;
+    }
+    text->length += (size_t)written;
+}
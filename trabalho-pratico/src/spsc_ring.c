@@ -0,0 +1,66 @@
+#include "../include/spsc_ring.h"
+#include <sched.h>
+#include <stdlib.h>
+#include <time.h>
+
+bool spsc_ring_init(SpscRing* ring, size_t capacity) {
+    size_t size = 1;
+    while (size < capacity) size <<= 1;
+    
+    ring->slots = malloc(size * sizeof(void*));
+    if (!ring->slots) return false;
+    ring->mask = size - 1;
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    return true;
+}
+
+void spsc_ring_destroy(SpscRing* ring) {
+    free(ring->slots);
+    ring->slots = NULL;
+}
+
+bool spsc_ring_try_push(SpscRing* ring, void* item) {
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    size_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    if (tail - head > ring->mask) return false;
+    
+    ring->slots[tail & ring->mask] = item;
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+bool spsc_ring_try_pop(SpscRing* ring, void** item) {
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    if (head == tail) return false;
+    
+    *item = ring->slots[head & ring->mask];
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+    return true;
+}
+
+// Waiting strategy for the blocking calls: stages are usually only briefly
+// out of step, so spin first and only sleep on long stalls
+static void backoff(unsigned* attempts) {
+    unsigned n = (*attempts)++;
+    if (n < 64) return;
+    if (n < 128) {
+        sched_yield();
+        return;
+    }
+    struct timespec pause = { 0, 50000 };   // 50 us
+    nanosleep(&pause, NULL);
+}
+
+void spsc_ring_push(SpscRing* ring, void* item) {
+    unsigned attempts = 0;
+    while (!spsc_ring_try_push(ring, item)) backoff(&attempts);
+}
+
+void* spsc_ring_pop(SpscRing* ring) {
+    unsigned attempts = 0;
+    void* item;
+    while (!spsc_ring_try_pop(ring, &item)) backoff(&attempts);
+    return item;
+}
@@ -0,0 +1,314 @@
+#include "../include/testes_validadores.h"
+#include "../include/parser_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+// Implementações de referência (versões originais baseadas em strlen/ctype),
+// usadas apenas para comparar com os validadores otimizados de parser_utils.c
+
+// Validate IATA airport code (3 uppercase letters)
+static bool ref_validate_airport_code(const char* code) {
+    if (!code || strlen(code) != 3) return false;
+    for (int i = 0; i < 3; i++) {
+        if (!isupper((unsigned char)code[i])) return false;
+    }
+    return true;
+}
+
+// Validate airport type
+static bool ref_validate_airport_type(const char* type) {
+    if (!type) return false;
+    return strcmp(type, "small_airport") == 0 ||
+           strcmp(type, "medium_airport") == 0 ||
+           strcmp(type, "large_airport") == 0 ||
+           strcmp(type, "heliport") == 0 ||
+           strcmp(type, "seaplane_base") == 0;
+}
+
+// Validate email format (username@domain.tld)
+static bool ref_validate_email(const char* email) {
+    if (!email) return false;
+    
+    const char* at = strchr(email, '@');
+    if (!at || at == email) return false;
+    
+    const char* dot = strchr(at, '.');
+    if (!dot || dot == at + 1 || dot[1] == '\0') return false;
+    
+    // Check that rstring (after last dot) is 2-3 characters
+    const char* last_dot = strrchr(at, '.');
+    size_t rstring_len = strlen(last_dot + 1);
+    if (rstring_len < 2 || rstring_len > 3) return false;
+    
+    // Check username part [a-z0-9.]
+    for (const char* p = email; p < at; p++) {
+        if (!islower((unsigned char)*p) && !isdigit((unsigned char)*p) && *p != '.') {
+            return false;
+        }
+    }
+    
+    // Check domain part [a-z] only (no digits in spec)
+    for (const char* p = at + 1; *p; p++) {
+        if (!islower((unsigned char)*p) && *p != '.') {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+// Validate gender (M, F, or O)
+static bool ref_validate_gender(const char* gender_str) {
+    if (!gender_str || strlen(gender_str) != 1) return false;
+    char g = gender_str[0];
+    return g == 'M' || g == 'F' || g == 'O';
+}
+
+// Validate flight ID (2 letters + 5 digits, e.g., KS07323) - strict as per spec
+static bool ref_validate_flight_id(const char* id) {
+    if (!id || strlen(id) != 7) return false;
+    if (!isupper((unsigned char)id[0]) || !isupper((unsigned char)id[1])) return false;
+    for (int i = 2; i < 7; i++) {
+        if (!isdigit((unsigned char)id[i])) return false;
+    }
+    return true;
+}
+
+// Validate reservation ID (R + 9 digits)
+static bool ref_validate_reservation_id(const char* id) {
+    if (!id || strlen(id) != 10) return false;
+    if (id[0] != 'R') return false;
+    for (int i = 1; i < 10; i++) {
+        if (!isdigit((unsigned char)id[i])) return false;
+    }
+    return true;
+}
+
+// Validate document number (9 digits)
+static bool ref_validate_document_number(const char* doc) {
+    if (!doc || strlen(doc) != 9) return false;
+    for (int i = 0; i < 9; i++) {
+        if (!isdigit((unsigned char)doc[i])) return false;
+    }
+    return true;
+}
+
+// Validate date format (aaaa-mm-dd) - STRICT: only hyphens, no future dates
+static bool ref_validate_date(const char* date_str) {
+    if (!date_str || strlen(date_str) != 10) return false;
+    
+    // Must use hyphens, not slashes
+    if (date_str[4] != '-' || date_str[7] != '-') {
+        return false;
+    }
+    
+    // Check all other characters are digits
+    for (int i = 0; i < 10; i++) {
+        if (i == 4 || i == 7) continue;
+        if (!isdigit((unsigned char)date_str[i])) return false;
+    }
+    
+    int year, month, day;
+    if (sscanf(date_str, "%d-%d-%d", &year, &month, &day) != 3) {
+        return false;
+    }
+    
+    if (month < 1 || month > 12) return false;
+    if (day < 1 || day > 31) return false;
+    
+    // Check date is not in the future
+    time_t now = time(NULL);
+    struct tm* current = localtime(&now);
+    int current_year = current->tm_year + 1900;
+    int current_month = current->tm_mon + 1;
+    int current_day = current->tm_mday;
+    
+    if (year > current_year) return false;
+    if (year == current_year && month > current_month) return false;
+    if (year == current_year && month == current_month && day > current_day) return false;
+    
+    return true;
+}
+
+// Validate datetime format (aaaa-mm-dd hh:mm) - STRICT: only hyphens allowed
+static bool ref_validate_datetime(const char* datetime_str) {
+    if (!datetime_str || strlen(datetime_str) != 16) return false;
+    
+    // Check format strictly: aaaa-mm-dd hh:mm (only hyphens allowed)
+    if (datetime_str[4] != '-' || datetime_str[7] != '-' || 
+        datetime_str[10] != ' ' || datetime_str[13] != ':') {
+        return false;
+    }
+    
+    // Check all digit positions
+    for (int i = 0; i < 16; i++) {
+        if (i == 4 || i == 7 || i == 10 || i == 13) continue;
+        if (!isdigit((unsigned char)datetime_str[i])) return false;
+    }
+    
+    int year, month, day, hour, minute;
+    if (sscanf(datetime_str, "%d-%d-%d %d:%d", 
+               &year, &month, &day, &hour, &minute) != 5) {
+        return false;
+    }
+    
+    if (month < 1 || month > 12) return false;
+    if (day < 1 || day > 31) return false;
+    if (hour < 0 || hour > 23) return false;
+    if (minute < 0 || minute > 59) return false;
+    
+    // For flights, we don't reject future dates as flights are scheduled in advance
+    // Only reject dates that are clearly invalid (e.g., year < 1900 or > 2100)
+    if (year < 1900 || year > 2100) return false;
+    
+    return true;
+}
+
+// Gerador pseudo-aleatório determinístico (xorshift32)
+static unsigned next_random(unsigned* state) {
+    unsigned x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+// Exemplos válidos usados como base para mutações
+static const char* const SEEDS[] = {
+    "KS07323", "R000000123", "123456789", "2023-04-06", "2023-04-06 12:30",
+    "1999-12-31 23:59", "ab.cd@mail.com", "joao1.silva@uminho.pt", "LIS",
+    "small_airport", "medium_airport", "large_airport", "heliport",
+    "seaplane_base", "M", "F", "O", "2100-01-01 00:00", "1900-01-01 00:00"
+};
+
+// Alfabeto enviesado para os caracteres que os validadores distinguem
+static const char ALPHABET[] =
+    "0123456789ABRZKSMFO azmlhse.@-:_'\t\n\x7f\x80\xc3\xff";
+
+static void random_string(unsigned* state, char* out, size_t max_len) {
+    size_t nseeds = sizeof(SEEDS) / sizeof(SEEDS[0]);
+    unsigned mode = next_random(state) % 3;
+    size_t len;
+
+    if (mode == 0) {
+        // Sequência aleatória
+        len = next_random(state) % 20;
+        if (len > max_len) len = max_len;
+        for (size_t i = 0; i < len; i++) {
+            out[i] = ALPHABET[next_random(state) % (sizeof(ALPHABET) - 1)];
+        }
+        out[len] = '\0';
+        return;
+    }
+
+    // Mutação de um exemplo válido
+    const char* seed = SEEDS[next_random(state) % nseeds];
+    len = strlen(seed);
+    if (len > max_len) len = max_len;
+    memcpy(out, seed, len);
+    out[len] = '\0';
+
+    unsigned mutations = mode == 1 ? 1 : next_random(state) % 4;
+    for (unsigned m = 0; m < mutations && len > 0; m++) {
+        size_t pos = next_random(state) % len;
+        switch (next_random(state) % 4) {
+            case 0: // Substituir
+                out[pos] = ALPHABET[next_random(state) % (sizeof(ALPHABET) - 1)];
+                break;
+            case 1: // Truncar
+                out[pos] = '\0';
+                len = pos;
+                break;
+            case 2: // Acrescentar
+                if (len < max_len) {
+                    out[len] = ALPHABET[next_random(state) % (sizeof(ALPHABET) - 1)];
+                    out[++len] = '\0';
+                }
+                break;
+            default: // Incrementar um dígito
+                if (out[pos] >= '0' && out[pos] < '9') out[pos]++;
+                break;
+        }
+    }
+}
+
+typedef struct {
+    const char* name;
+    bool (*optimized)(const char*);
+    bool (*reference)(const char*);
+    bool padded;               // só recebe valores com FIELD_PADDING bytes legíveis depois
+} ValidatorPair;
+
+static const ValidatorPair VALIDATORS[] = {
+    {"validate_airport_code", validate_airport_code, ref_validate_airport_code, false},
+    {"validate_airport_type", validate_airport_type, ref_validate_airport_type, false},
+    {"validate_email", validate_email, ref_validate_email, false},
+    {"validate_gender", validate_gender, ref_validate_gender, false},
+    {"validate_flight_id", validate_flight_id, ref_validate_flight_id, false},
+    {"validate_reservation_id", validate_reservation_id, ref_validate_reservation_id, false},
+    {"validate_document_number", validate_document_number, ref_validate_document_number, false},
+    {"validate_date", validate_date, ref_validate_date, false},
+    {"validate_datetime", validate_datetime, ref_validate_datetime, false},
+    {"validate_flight_id_padded", validate_flight_id_padded, ref_validate_flight_id, true},
+    {"validate_reservation_id_padded", validate_reservation_id_padded, ref_validate_reservation_id, true},
+    {"validate_document_number_padded", validate_document_number_padded, ref_validate_document_number, true},
+    {"validate_date_padded", validate_date_padded, ref_validate_date, true},
+    {"validate_datetime_padded", validate_datetime_padded, ref_validate_datetime, true},
+};
+
+int run_validators_differential_test(unsigned iterations, unsigned seed) {
+    size_t nvalidators = sizeof(VALIDATORS) / sizeof(VALIDATORS[0]);
+    unsigned state = seed ? seed : 1u;
+    int mismatches = 0;
+
+    // Duas páginas, a segunda sem acesso: os casos colocados no fim da
+    // primeira página garantem que nenhum validador lê além do terminador
+    long page = sysconf(_SC_PAGESIZE);
+    char* guard = mmap(NULL, (size_t)page * 2, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (guard == MAP_FAILED) {
+        fprintf(stderr, "Erro ao reservar memoria para o teste de validadores\n");
+        return -1;
+    }
+    mprotect(guard + page, (size_t)page, PROT_NONE);
+
+    // Casos até 24 caracteres: o buffer deixa sempre FIELD_PADDING bytes livres
+    char buffer[24 + 1 + FIELD_PADDING];
+    for (unsigned it = 0; it < iterations; it++) {
+        random_string(&state, buffer, 24);
+        size_t len = strlen(buffer);
+
+        // Alternar entre um buffer normal e o fim da página protegida
+        const char* input = buffer;
+        if (it & 1u) {
+            char* at_page_end = guard + page - (len + 1);
+            memcpy(at_page_end, buffer, len + 1);
+            input = at_page_end;
+        }
+
+        for (size_t v = 0; v < nvalidators; v++) {
+            if (VALIDATORS[v].padded && input != buffer) continue;
+            bool expected = VALIDATORS[v].reference(input);
+            bool actual = VALIDATORS[v].optimized(input);
+            if (expected != actual) {
+                if (mismatches < 10) {
+                    printf("Divergencia em %s(\"%s\"): esperado %d, obtido %d\n",
+                           VALIDATORS[v].name, input, expected, actual);
+                }
+                mismatches++;
+            }
+        }
+    }
+
+    munmap(guard, (size_t)page * 2);
+
+    printf("Teste diferencial de validadores: %u casos x %zu validadores, %d divergencias\n",
+           iterations, nvalidators, mismatches);
+    return mismatches;
+}
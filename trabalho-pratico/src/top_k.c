@@ -0,0 +1,152 @@
+#include "../include/top_k.h"
+
+#define HEAP_MAX_K 64              // bounded heap up to this k, introselect above
+#define INSERTION_SORT_MAX 16
+
+uint64_t top_k_pack(uint32_t count, uint32_t tiebreak) {
+    return ((uint64_t)(UINT32_MAX - count) << 32) | tiebreak;
+}
+
+uint32_t top_k_count(uint64_t key) {
+    return UINT32_MAX - (uint32_t)(key >> 32);
+}
+
+uint32_t top_k_tiebreak(uint64_t key) {
+    return (uint32_t)key;
+}
+
+static void swap_keys(uint64_t* a, uint64_t* b) {
+    uint64_t t = *a;
+    *a = *b;
+    *b = t;
+}
+
+// Max-heap on heap[0..n)
+static void sift_down(uint64_t* heap, size_t n, size_t i) {
+    for (;;) {
+        size_t largest = i, left = 2 * i + 1, right = left + 1;
+        if (left < n && heap[left] > heap[largest]) largest = left;
+        if (right < n && heap[right] > heap[largest]) largest = right;
+        if (largest == i) return;
+        swap_keys(&heap[i], &heap[largest]);
+        i = largest;
+    }
+}
+
+static void heapify(uint64_t* keys, size_t n) {
+    for (size_t i = n / 2; i-- > 0;) sift_down(keys, n, i);
+}
+
+static void heap_sort(uint64_t* keys, size_t n) {
+    heapify(keys, n);
+    for (size_t end = n; end > 1; end--) {
+        swap_keys(&keys[0], &keys[end - 1]);
+        sift_down(keys, end - 1, 0);
+    }
+}
+
+static void insertion_sort(uint64_t* keys, size_t n) {
+    for (size_t i = 1; i < n; i++) {
+        uint64_t key = keys[i];
+        size_t j = i;
+        while (j > 0 && keys[j - 1] > key) {
+            keys[j] = keys[j - 1];
+            j--;
+        }
+        keys[j] = key;
+    }
+}
+
+// Hoare partition around the median of first, middle and last; returns
+// p such that keys[0..p] <= pivot <= keys[p+1..n)
+static size_t partition(uint64_t* keys, size_t n) {
+    size_t mid = n / 2;
+    if (keys[mid] < keys[0]) swap_keys(&keys[mid], &keys[0]);
+    if (keys[n - 1] < keys[0]) swap_keys(&keys[n - 1], &keys[0]);
+    if (keys[n - 1] < keys[mid]) swap_keys(&keys[n - 1], &keys[mid]);
+    uint64_t pivot = keys[mid];
+    
+    size_t i = 0, j = n - 1;
+    for (;;) {
+        while (keys[i] < pivot) i++;
+        while (keys[j] > pivot) j--;
+        if (i >= j) return j;
+        swap_keys(&keys[i++], &keys[j--]);
+    }
+}
+
+static unsigned depth_limit(size_t n) {
+    unsigned depth = 0;
+    while (n >>= 1) depth++;
+    return 2 * depth;
+}
+
+// Introsort
+static void sort_keys(uint64_t* keys, size_t n, unsigned depth) {
+    while (n > INSERTION_SORT_MAX) {
+        if (depth-- == 0) {
+            heap_sort(keys, n);
+            return;
+        }
+        size_t p = partition(keys, n) + 1;
+        // Recurse into the smaller side, loop on the larger one
+        if (p < n - p) {
+            sort_keys(keys, p, depth);
+            keys += p;
+            n -= p;
+        } else {
+            sort_keys(keys + p, n - p, depth);
+            n = p;
+        }
+    }
+    insertion_sort(keys, n);
+}
+
+// Introselect: afterwards keys[0..k) are the k smallest (unordered)
+static void select_keys(uint64_t* keys, size_t n, size_t k) {
+    unsigned depth = depth_limit(n);
+    while (n > INSERTION_SORT_MAX && k > 0 && k < n) {
+        if (depth-- == 0) {
+            // Heap selection: keep the k smallest in a max-heap at the front
+            heapify(keys, k);
+            for (size_t i = k; i < n; i++) {
+                if (keys[i] < keys[0]) {
+                    swap_keys(&keys[i], &keys[0]);
+                    sift_down(keys, k, 0);
+                }
+            }
+            return;
+        }
+        size_t p = partition(keys, n) + 1;
+        if (k <= p) {
+            n = p;
+        } else {
+            keys += p;
+            n -= p;
+            k -= p;
+        }
+    }
+    if (k > 0 && k < n) insertion_sort(keys, n);
+}
+
+size_t top_k_select(uint64_t* keys, size_t n, size_t k) {
+    if (k > n) k = n;
+    if (k == 0) return 0;
+    
+    if (k <= HEAP_MAX_K && k < n) {
+        // Bounded heap: keys[0..k) holds the k smallest seen so far
+        heapify(keys, k);
+        for (size_t i = k; i < n; i++) {
+            if (keys[i] < keys[0]) {
+                swap_keys(&keys[i], &keys[0]);
+                sift_down(keys, k, 0);
+            }
+        }
+        heap_sort(keys, k);
+        return k;
+    }
+    
+    select_keys(keys, n, k);
+    sort_keys(keys, k, depth_limit(k));
+    return k;
+}